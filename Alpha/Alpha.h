@@ -4,3 +4,4 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_STATS_GROUP(TEXT("Alpha Movement"), STATGROUP_AlphaMovement, STATCAT_Advanced);
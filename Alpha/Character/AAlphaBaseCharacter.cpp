@@ -2,8 +2,20 @@
 #include "EnhancedInput/Public/EnhancedInputSubsystems.h"
 #include "EnhancedInput/Public/EnhancedInputComponent.h"
 #include "UAlphaInputConfig.h"
+#include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarShowVelocity(
+	TEXT("alpha.Debug.ShowVelocity"),
+	0,
+	TEXT("Prints the locally controlled character's speed on screen every frame. 0: off, 1: on"),
+	ECVF_Cheat);
+
+// Source view offsets, 28 units ducked for 64 standing
+const float CROUCHED_EYE_HEIGHT_SCALE = 28.0f / 64.0f;
 
 AAlphaBaseCharacter::AAlphaBaseCharacter()
 {
@@ -23,6 +35,13 @@ AAlphaBaseCharacter::AAlphaBaseCharacter()
 	bUseControllerRotationRoll = true;
 	PrimaryActorTick.bCanEverTick = true;
 
+	NetLocation = FVector::ZeroVector;
+	NetVelocity = FVector::ZeroVector;
+	NetTime = 0.0f;
+	NetExtrapolationError = 0.0f;
+	bPooled = false;
+	CameraComponent = nullptr;
+
 	MovementPtr = Cast<UAlphaMovementConfig>(ACharacter::GetMovementComponent());
 }
 
@@ -36,16 +55,152 @@ void AAlphaBaseCharacter::Tick(float DeltaSeconds)
 		Super::StopJumping();
 	}
 
-	// print debug to screen
-	GEngine->AddOnScreenDebugMessage(-1, 0.01f, FColor::Cyan, FString::Printf(TEXT("vel: %f"), GetVelocity().Size()));
+	if (bAdaptiveNetUpdate && HasAuthority() && GetNetMode() != NM_Standalone)
+		UpdateNetRate(DeltaSeconds);
+
+	// crouching moves the eye height, the camera sits where the pawn's view point would be
+	if (CameraComponent && CameraComponent->IsActive())
+		CameraComponent->SetRelativeLocation(FVector(0.0f, 0.0f, APawn::BaseEyeHeight));
+
+	// formatting the message allocates, only pay for it when asked
+	if (CVarShowVelocity.GetValueOnGameThread() > 0 && GEngine && IsLocallyControlled())
+		GEngine->AddOnScreenDebugMessage(-1, 0.01f, FColor::Cyan, FString::Printf(TEXT("vel: %f"), GetVelocity().Size()));
+}
+
+void AAlphaBaseCharacter::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	NetLocation = GetActorLocation();
+	NetVelocity = GetVelocity();
+	NetTime = GetWorld()->GetTimeSeconds();
+}
+
+void AAlphaBaseCharacter::ResetForRespawn(const FTransform& SpawnTransform)
+{
+	bPooled = false;
+	bWantsToWalk = false;
+	bIsWalking = false;
+	bDeferJumpStop = false;
+
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	ResetJumpState();
+
+	if (MovementPtr)
+	{
+		MovementPtr->SetComponentTickEnabled(true);
+		MovementPtr->ResetForRespawn();
+	}
+
+	// proxies would otherwise extrapolate from where the character died
+	NetLocation = GetActorLocation();
+	NetVelocity = FVector::ZeroVector;
+	NetTime = GetWorld()->GetTimeSeconds();
+	NetExtrapolationError = 0.0f;
+	ForceNetUpdate();
+}
+
+void AAlphaBaseCharacter::DeactivateForPool()
+{
+	bPooled = true;
+
+	if (MovementPtr)
+	{
+		MovementPtr->StopMovementImmediately();
+		MovementPtr->SetComponentTickEnabled(false);
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	ForceNetUpdate();
+}
+
+void AAlphaBaseCharacter::UpdateNetRate(float DeltaSeconds)
+{
+	// simulated proxies carry on in a straight line until the next update
+	const FVector Extrapolated = NetLocation + NetVelocity * (GetWorld()->GetTimeSeconds() - NetTime);
+	NetExtrapolationError = FVector::Dist(GetActorLocation(), Extrapolated);
+
+	const float SpeedAlpha = FMath::Clamp(GetVelocity().Size() / FastNetSpeed, 0.0f, 1.0f);
+	const float ErrorAlpha = FMath::Clamp(NetExtrapolationError / FastNetError, 0.0f, 1.0f);
+	// past the movement budget's proxy tier the character replicates as if idle, players too
+	const bool bThrottled = MovementPtr && MovementPtr->IsProxyRateReduced();
+	const float Alpha = bThrottled ? 0.0f : FMath::Max(SpeedAlpha, ErrorAlpha);
+
+	const float TargetFrequency = FMath::Lerp(IdleNetUpdateFrequency, FastNetUpdateFrequency, Alpha);
+
+	// speed up at once, slow down over a second or so to avoid flapping on every jump
+	NetUpdateFrequency = TargetFrequency > NetUpdateFrequency ? TargetFrequency : FMath::FInterpTo(NetUpdateFrequency, TargetFrequency, DeltaSeconds, 2.0f);
+	MinNetUpdateFrequency = FMath::Min(IdleNetUpdateFrequency, NetUpdateFrequency);
+	NetPriority = FMath::Lerp(IdleNetPriority, FastNetPriority, Alpha);
+
+	if (!bThrottled && ForceNetUpdateError > 0.0f && NetExtrapolationError > ForceNetUpdateError)
+	{
+		ForceNetUpdate();
+
+		// only force once per divergence, PreReplication resets the reference
+		NetLocation = GetActorLocation();
+		NetVelocity = GetVelocity();
+		NetTime = GetWorld()->GetTimeSeconds();
+	}
+}
+
+void AAlphaBaseCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	// runs wherever the controller changes, including replicated controllers on clients
+	if (IsLocallyPlayerControlled())
+		ActivateLocalComponents();
+	else
+		DeactivateLocalComponents();
+}
+
+void AAlphaBaseCharacter::ActivateLocalComponents()
+{
+	if (CameraComponent)
+	{
+		CameraComponent->Activate();
+		return;
+	}
+
+	CameraComponent = NewObject<UCameraComponent>(this, TEXT("CameraComponent"));
+	CameraComponent->SetupAttachment(GetCapsuleComponent());
+	CameraComponent->SetRelativeLocation(FVector(0.0f, 0.0f, APawn::BaseEyeHeight));
+	CameraComponent->bUsePawnControlRotation = true;
+	CameraComponent->RegisterComponent();
+}
+
+void AAlphaBaseCharacter::DeactivateLocalComponents()
+{
+	// an inactive camera is skipped when the character is a view target, it is reused on the next possession
+	if (CameraComponent)
+		CameraComponent->Deactivate();
 }
 
 void AAlphaBaseCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	const APlayerController* PlayerController = Cast<APlayerController>(GetController());
+
+	if (PlayerController == nullptr || !PlayerController->IsLocalController())
+		return;
+
 	UEnhancedInputLocalPlayerSubsystem* Subsystem = ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer());
+
+	if (Subsystem == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UEnhancedInputLocalPlayerSubsystem nullptr"));
+		return;
+	}
 	
-	Subsystem->AddMappingContext(InputContext, 0);
+	// pooled characters are set up again on every possession, the context stays on the local player
+	if (!Subsystem->HasMappingContext(InputContext))
+		Subsystem->AddMappingContext(InputContext, 0);
 
 	if (InputActions == nullptr)
 	{
@@ -70,6 +225,12 @@ void AAlphaBaseCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInput
 			PlayerEnhancedInputComponent->BindAction(InputActions->InputJump, ETriggerEvent::Triggered, this, &AAlphaBaseCharacter::Jump);
 		}
 
+		if (InputActions->InputCrouch)
+		{
+			PlayerEnhancedInputComponent->BindAction(InputActions->InputCrouch, ETriggerEvent::Started, this, &AAlphaBaseCharacter::StartCrouch);
+			PlayerEnhancedInputComponent->BindAction(InputActions->InputCrouch, ETriggerEvent::Completed, this, &AAlphaBaseCharacter::StopCrouch);
+		}
+
 		if (InputActions->InputSpecial1)
 		{
 			PlayerEnhancedInputComponent->BindAction(InputActions->InputSpecial1, ETriggerEvent::Triggered, this, &AAlphaBaseCharacter::SpecialA1);
@@ -99,6 +260,31 @@ void AAlphaBaseCharacter::Jump()
 	Super::Jump();
 }
 
+bool AAlphaBaseCharacter::CanJumpInternal_Implementation() const
+{
+	// crouch jumping is allowed, the capsule stays crouched
+	return JumpIsAllowedInternal();
+}
+
+void AAlphaBaseCharacter::StartCrouch()
+{
+	Crouch();
+}
+
+void AAlphaBaseCharacter::StopCrouch()
+{
+	UnCrouch();
+}
+
+void AAlphaBaseCharacter::SetBaseEyeHeight(float NewBaseEyeHeight)
+{
+	BaseEyeHeight = NewBaseEyeHeight;
+
+	// the view location comes from the pawn's eye heights
+	APawn::BaseEyeHeight = NewBaseEyeHeight;
+	CrouchedEyeHeight = NewBaseEyeHeight * CROUCHED_EYE_HEIGHT_SCALE;
+}
+
 void AAlphaBaseCharacter::Move(const FInputActionValue& Value)
 {
 	if (Controller == nullptr)
@@ -182,4 +368,49 @@ void AAlphaBaseCharacter::SpecialA2(const FInputActionValue& Value)
 		// TODO: Trigger special ability 2
 		GEngine->AddOnScreenDebugMessage(3, 5.0f, FColor::Green, FString::Printf(TEXT("special 2 true")));
 	}
-}
\ No newline at end of file
+}
+
+static FAutoConsoleCommandWithWorld AlphaCharacterFootprintCommand(
+	TEXT("alpha.Debug.CharacterFootprint"),
+	TEXT("Logs the average component count and memory of locally controlled, simulated and server characters"),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (World == nullptr)
+			return;
+
+		// the owning client's copy, other clients' copies and the server's copy
+		const TCHAR* GroupNames[] = { TEXT("local"), TEXT("simulated"), TEXT("server") };
+		int32 Characters[3] = { 0, 0, 0 };
+		int32 Components[3] = { 0, 0, 0 };
+		SIZE_T Bytes[3] = { 0, 0, 0 };
+
+		for (TActorIterator<AAlphaBaseCharacter> It(World); It; ++It)
+		{
+			AAlphaBaseCharacter* Character = *It;
+			const int32 Group = Character->IsLocallyPlayerControlled() ? 0 : Character->GetLocalRole() == ROLE_Authority ? 2 : 1;
+
+			// object sizes plus whatever each object reports owning
+			FResourceSizeEx Size(EResourceSizeMode::Exclusive);
+			Character->GetResourceSizeEx(Size);
+			Bytes[Group] += Character->GetClass()->GetStructureSize() + Size.GetTotalMemoryBytes();
+
+			for (UActorComponent* Component : Character->GetComponents())
+			{
+				FResourceSizeEx ComponentSize(EResourceSizeMode::Exclusive);
+				Component->GetResourceSizeEx(ComponentSize);
+				Bytes[Group] += Component->GetClass()->GetStructureSize() + ComponentSize.GetTotalMemoryBytes();
+				Components[Group]++;
+			}
+
+			Characters[Group]++;
+		}
+
+		for (int32 Group = 0; Group < 3; Group++)
+		{
+			if (Characters[Group] == 0)
+				continue;
+
+			UE_LOG(LogTemp, Display, TEXT("%s characters: %d, %.1f components and %.1f KB each"), GroupNames[Group], Characters[Group], static_cast<float>(Components[Group]) / Characters[Group], Bytes[Group] / 1024.0f / Characters[Group]);
+		}
+	})
+);
@@ -9,7 +9,10 @@ class AAlphaBaseCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = true))
+	/**
+	 * Only exists on characters a local player has controlled, see ActivateLocalComponents
+	 */
+	UPROPERTY(Transient, VisibleInstanceOnly, BlueprintReadOnly, Category = "Camera", meta = (AllowPrivateAccess = true))
 	class UCameraComponent* CameraComponent;
 	
 public:
@@ -32,10 +35,10 @@ public:
 	float GetBaseEyeHeight() { return BaseEyeHeight; }
 
 	/**
-	 * Sets the eye height (in units) the camera should be moved on the y-axis
+	 * Sets the eye height (in units) the camera should be moved on the y-axis, the crouched eye height follows it
 	 * @param NewBaseEyeHeight Distance in units
 	 */
-	void SetBaseEyeHeight(float NewBaseEyeHeight) { BaseEyeHeight = NewBaseEyeHeight; }
+	void SetBaseEyeHeight(float NewBaseEyeHeight);
 
 	/**
 	 * Sets the name of the character
@@ -94,12 +97,97 @@ public:
 		 return bIsWalking;
 	}
 	
+	/**
+	 * Returns the view camera, null until a local player controls the character and inactive while none does
+	 */
+	class UCameraComponent* GetCameraComponent() const
+	{
+		return CameraComponent;
+	}
+
 	virtual void Tick(float DeltaSeconds) override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
+	virtual void NotifyControllerChanged() override;
+	virtual void PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
+
+	/**
+	 * Puts the character back into play at a transform after it was pooled, see UAlphaCharacterPoolSubsystem
+	 */
+	virtual void ResetForRespawn(const FTransform& SpawnTransform);
+
+	/**
+	 * Hides the character and stops it from ticking or colliding until it is respawned
+	 */
+	virtual void DeactivateForPool();
+
+	bool IsPooled() const
+	{
+		return bPooled;
+	}
+
+	/**
+	 * Returns how far (in units) the character is from where proxies extrapolate it since its last replication
+	 */
+	float GetNetExtrapolationError() const
+	{
+		return NetExtrapolationError;
+	}
 
 protected:
 	virtual void BeginPlay() override;
 
+	/**
+	 * Creates the components only the owning client uses the first time a local player takes control, simulated
+	 * proxies and the server never pay for them. They are kept and only deactivated while nobody local controls the
+	 * character, so possessing it again doesn't create them anew
+	 */
+	virtual void ActivateLocalComponents();
+	virtual void DeactivateLocalComponents();
+
+	/**
+	 * Scales net update frequency and priority with speed and extrapolation error on the server
+	 */
+	void UpdateNetRate(float DeltaSeconds);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication")
+	bool bAdaptiveNetUpdate = true;
+
+	/**
+	 * Net update frequency and priority used while standing still
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "1", UIMin = "1"))
+	float IdleNetUpdateFrequency = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "0", UIMin = "0"))
+	float IdleNetPriority = 1.0f;
+
+	/**
+	 * Net update frequency and priority used at FastNetSpeed or FastNetError
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "1", UIMin = "1"))
+	float FastNetUpdateFrequency = 100.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "0", UIMin = "0"))
+	float FastNetPriority = 4.0f;
+
+	/**
+	 * Speed (unit/s) at which the fast net rate is reached
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "1", UIMin = "1"))
+	float FastNetSpeed = 1500.0f;
+
+	/**
+	 * Extrapolation error (in units) at which the fast net rate is reached
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "1", UIMin = "1"))
+	float FastNetError = 16.0f;
+
+	/**
+	 * Extrapolation error (in units) which replicates on the next net tick, zero to disable
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (EditCondition = "bAdaptiveNetUpdate", ClampMin = "0", UIMin = "0"))
+	float ForceNetUpdateError = 48.0f;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Enhanced Input from Script")
 	class UInputMappingContext* InputContext;
 
@@ -109,6 +197,9 @@ protected:
 	void Move(const FInputActionValue& Value);
 	void Look(const FInputActionValue& Value);
 	virtual void Jump() override;
+	virtual bool CanJumpInternal_Implementation() const override;
+	void StartCrouch();
+	void StopCrouch();
 	virtual void SpecialA1(const FInputActionValue& Value);
 	virtual void SpecialA2(const FInputActionValue& Value);
 	// void UltimateA(const FInputActionValue& Value);
@@ -125,4 +216,13 @@ private:
 	bool bWantsToWalk;
 	bool bIsWalking;
 	bool bDeferJumpStop;
+	bool bPooled;
+
+	/**
+	 * State sent with the last replication, proxies extrapolate from it
+	 */
+	FVector NetLocation;
+	FVector NetVelocity;
+	float NetTime;
+	float NetExtrapolationError;
 };
@@ -0,0 +1,63 @@
+#include "FAlphaAsyncMovement.h"
+#include "Misc/ScopeLock.h"
+
+// steps queued between two game thread collections, about half a second of physics at 128Hz
+const int32 MAX_QUEUED_STEPS = 64;
+
+FAlphaAsyncMovementBuffer::FAlphaAsyncMovementBuffer()
+{
+	Steps.Reserve(MAX_QUEUED_STEPS);
+}
+
+void FAlphaAsyncMovementBuffer::PushInput(const FAlphaAsyncMovementInput& Input)
+{
+	FScopeLock ScopeLock(&Lock);
+	PendingInput = Input;
+	bHasPendingInput = true;
+}
+
+bool FAlphaAsyncMovementBuffer::PopInput(FAlphaAsyncMovementInput& OutInput)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (!bHasPendingInput)
+		return false;
+
+	OutInput = PendingInput;
+	bHasPendingInput = false;
+	return true;
+}
+
+void FAlphaAsyncMovementBuffer::PushStep(const FAlphaAsyncMovementStep& Step)
+{
+	FScopeLock ScopeLock(&Lock);
+
+	if (Steps.Num() < MAX_QUEUED_STEPS)
+	{
+		Steps.Add(Step);
+		return;
+	}
+
+	// keeps the time without allocating, the game thread redoes merged steps itself
+	FAlphaAsyncMovementStep& Last = Steps.Last();
+	Last.Input.DeltaTime += Step.Input.DeltaTime;
+	Last.bMerged = true;
+}
+
+void FAlphaAsyncMovementBuffer::PopSteps(TArray<FAlphaAsyncMovementStep>& OutSteps)
+{
+	// swapping hands the caller's allocation to the physics side, neither grows after warming up
+	OutSteps.Reset();
+
+	FScopeLock ScopeLock(&Lock);
+	Swap(Steps, OutSteps);
+}
+
+void FAlphaAsyncMovementBuffer::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Steps.Reset();
+	PendingInput = FAlphaAsyncMovementInput();
+	PendingInput.bStepping = false;
+	bHasPendingInput = true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "FAlphaVelocityKernel.h"
+
+/**
+ * Game thread state the async physics tick steps from
+ */
+struct FAlphaAsyncMovementInput
+{
+	FAlphaVelocityTuning Tuning;
+
+	/**
+	 * Velocity after the last game thread move and the latest input, DeltaTime is replaced by the physics step
+	 */
+	FAlphaVelocityInput State;
+
+	/**
+	 * Incremented by the game thread every time it pushes a new state
+	 */
+	uint32 Sequence = 0;
+
+	/**
+	 * False stops stepping until the next input, for modes the kernel doesn't cover
+	 */
+	bool bStepping = true;
+};
+
+/**
+ * One physics step, with the state it was stepped from so the game thread can redo it from its own velocity
+ */
+struct FAlphaAsyncMovementStep
+{
+	/**
+	 * DeltaTime is the length of the physics step
+	 */
+	FAlphaVelocityInput Input;
+	FAlphaVelocityOutput Result;
+
+	/**
+	 * Sequence of the game thread state the step was taken from
+	 */
+	uint32 BaseSequence = 0;
+
+	/**
+	 * Steps were folded into this one while the game thread wasn't collecting, Result only covers the first
+	 */
+	bool bMerged = false;
+};
+
+/**
+ * Hands movement state between the game thread and the async physics tick.
+ *
+ * Every physics step is queued in order until the game thread collects it, so no step is lost or applied twice
+ * however the two threads line up. Each side keeps working on its own copy, the lock is only held to copy a pending
+ * input or swap the step queue, so neither side waits on the other's simulation.
+ */
+class FAlphaAsyncMovementBuffer
+{
+public:
+	FAlphaAsyncMovementBuffer();
+
+	/**
+	 * Game thread, replaces any input the physics tick hasn't picked up yet
+	 */
+	void PushInput(const FAlphaAsyncMovementInput& Input);
+
+	/**
+	 * Physics thread
+	 * @return True if there was a new input since the last call
+	 */
+	bool PopInput(FAlphaAsyncMovementInput& OutInput);
+
+	/**
+	 * Physics thread, once the queue is full later steps are folded into the last one
+	 */
+	void PushStep(const FAlphaAsyncMovementStep& Step);
+
+	/**
+	 * Game thread, replaces OutSteps with every step queued since the last call, oldest first
+	 */
+	void PopSteps(TArray<FAlphaAsyncMovementStep>& OutSteps);
+
+	/**
+	 * Drops queued steps and stops stepping until the next input
+	 */
+	void Reset();
+
+private:
+	FCriticalSection Lock;
+	FAlphaAsyncMovementInput PendingInput;
+	TArray<FAlphaAsyncMovementStep> Steps;
+	bool bHasPendingInput = false;
+};
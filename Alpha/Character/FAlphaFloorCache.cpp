@@ -0,0 +1,260 @@
+#include "FAlphaFloorCache.h"
+#include "Components/PrimitiveComponent.h"
+
+// horizontal distance (in units) under which two queries sweep the same column, far below the collision contact offset
+const float SWEPT_HORIZONTAL_TOLERANCE = 0.001f;
+// horizontal distance (in units) a hit on a flat face is reused over. corrections only start above the engine's
+// position error of sqrt(3) units, so replayed moves rarely start in the column they swept originally
+const float FLOOR_REUSE_DISTANCE = 4.0f;
+// cached starts are filed under cells twice the reuse distance, a query looks in the 2x2 cells around it
+const float FLOOR_CELL_SIZE = FLOOR_REUSE_DISTANCE * 2.0f;
+// normals of a capsule resting on a face match, resting on an edge or a vertex they don't
+const float FACE_CONTACT_TOLERANCE = 0.001f;
+
+FAlphaFloorCache::FAlphaFloorCache(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 1);
+	NextFloor = 0;
+	NextTrace = 0;
+}
+
+bool FAlphaFloorCache::IsCacheable(const FHitResult& Hit)
+{
+	if (!Hit.bBlockingHit)
+		return true;
+
+	const UPrimitiveComponent* Component = Hit.GetComponent();
+	return Component && Component->Mobility == EComponentMobility::Static && !Hit.bStartPenetrating;
+}
+
+uint32 FAlphaFloorCache::GetKey(const FVector& Start, float LineDistance, float SweepDistance, float SweepRadius)
+{
+	uint32 Key = HashCombine(GetTypeHash(FMath::FloorToInt64(Start.X / FLOOR_CELL_SIZE)), GetTypeHash(FMath::FloorToInt64(Start.Y / FLOOR_CELL_SIZE)));
+	Key = HashCombine(Key, GetTypeHash(LineDistance));
+	Key = HashCombine(Key, GetTypeHash(SweepDistance));
+	return HashCombine(Key, GetTypeHash(SweepRadius));
+}
+
+bool FAlphaFloorCache::GetSweptOffset(const FVector& Start, const FVector& CachedStart, const FHitResult& CachedHit, FVector& OutOffset, float& OutHeight)
+{
+	OutOffset = Start - CachedStart;
+	OutHeight = OutOffset.Z;
+
+	const bool bSameColumn = FMath::Abs(OutOffset.X) <= SWEPT_HORIZONTAL_TOLERANCE && FMath::Abs(OutOffset.Y) <= SWEPT_HORIZONTAL_TOLERANCE;
+
+	// a miss only covers its own sweep, anything lower or to the side reaches space nobody swept
+	if (!CachedHit.bBlockingHit)
+		return bSameColumn && FMath::Abs(OutHeight) <= SWEPT_HORIZONTAL_TOLERANCE;
+
+	// the floor may have been streamed out since
+	if (CachedHit.GetComponent() == nullptr)
+		return false;
+
+	if (!bSameColumn)
+	{
+		if (FMath::Abs(OutOffset.X) > FLOOR_REUSE_DISTANCE || FMath::Abs(OutOffset.Y) > FLOOR_REUSE_DISTANCE)
+			return false;
+
+		// to the side of a face contact the capsule lands on the same face, only at the face's height there
+		const FVector& Normal = CachedHit.ImpactNormal;
+
+		if (!Normal.Equals(CachedHit.Normal, FACE_CONTACT_TOLERANCE) || Normal.Z <= KINDA_SMALL_NUMBER)
+			return false;
+
+		OutHeight -= -(Normal.X * OutOffset.X + Normal.Y * OutOffset.Y) / Normal.Z;
+	}
+
+	// below the cached start and above the hit, the sweep down reaches the same contact
+	return OutHeight <= SWEPT_HORIZONTAL_TOLERANCE && CachedHit.Distance + OutHeight >= 0.0f;
+}
+
+void FAlphaFloorCache::OffsetHit(FHitResult& Hit, const FVector& Offset, float Height)
+{
+	const float TraceLength = (Hit.TraceEnd - Hit.TraceStart).Size();
+
+	Hit.TraceStart += Offset;
+	Hit.TraceEnd += Offset;
+
+	if (!Hit.bBlockingHit)
+	{
+		Hit.Location += Offset;
+		return;
+	}
+
+	// the contact moves along the face, the trace start moves by the whole offset
+	const FVector ContactOffset = Offset - FVector(0.0f, 0.0f, Height);
+	Hit.Location += ContactOffset;
+	Hit.ImpactPoint += ContactOffset;
+	Hit.Distance += Height;
+
+	if (TraceLength > 0.0f)
+		Hit.Time = Hit.Distance / TraceLength;
+}
+
+void FAlphaFloorCache::FindCandidates(const TMap<uint32, int32>& Indices, const FVector& Start, FCandidates& OutCandidates, float LineDistance, float SweepDistance, float SweepRadius)
+{
+	// every start within the reuse distance is filed under one of these cells, the cell of the start itself goes
+	// first since it holds the entry for the same column if there is one
+	TArray<uint32, TInlineAllocator<4>> Keys;
+	Keys.Add(GetKey(Start, LineDistance, SweepDistance, SweepRadius));
+
+	for (const float X : { -FLOOR_REUSE_DISTANCE, FLOOR_REUSE_DISTANCE })
+	{
+		for (const float Y : { -FLOOR_REUSE_DISTANCE, FLOOR_REUSE_DISTANCE })
+			Keys.AddUnique(GetKey(Start + FVector(X, Y, 0.0f), LineDistance, SweepDistance, SweepRadius));
+	}
+
+	for (const uint32 Key : Keys)
+	{
+		if (const int32* Index = Indices.Find(Key))
+			OutCandidates.Add(*Index);
+	}
+}
+
+void FAlphaFloorCache::AddFloor(const FVector& Start, float LineDistance, float SweepDistance, float SweepRadius, const FFindFloorResult& Result)
+{
+	if (!IsCacheable(Result.HitResult))
+		return;
+
+	const uint32 Key = GetKey(Start, LineDistance, SweepDistance, SweepRadius);
+	FFloorEntry Entry{ Start, LineDistance, SweepDistance, SweepRadius, Result, Key };
+
+	// grows once to its full size instead of reallocating while it fills
+	if (Floors.Num() == 0)
+	{
+		Floors.Reserve(Capacity);
+		FloorIndices.Reserve(Capacity);
+	}
+
+	int32 Index = Floors.Num();
+
+	if (Index < Capacity)
+	{
+		Floors.Add(Entry);
+	}
+	else
+	{
+		Index = NextFloor;
+		NextFloor = (NextFloor + 1) % Capacity;
+
+		// a newer entry may have taken over the key of the one being replaced
+		const int32* OldIndex = FloorIndices.Find(Floors[Index].Key);
+
+		if (OldIndex && *OldIndex == Index)
+			FloorIndices.Remove(Floors[Index].Key);
+
+		Floors[Index] = Entry;
+	}
+
+	FloorIndices.Add(Key, Index);
+}
+
+bool FAlphaFloorCache::FindFloor(const FVector& Start, float LineDistance, float SweepDistance, float SweepRadius, FFindFloorResult& OutResult) const
+{
+	FCandidates Candidates;
+	FindCandidates(FloorIndices, Start, Candidates, LineDistance, SweepDistance, SweepRadius);
+
+	for (const int32 Index : Candidates)
+	{
+		const FFloorEntry& Entry = Floors[Index];
+
+		if (Entry.LineDistance != LineDistance || Entry.SweepDistance != SweepDistance || Entry.SweepRadius != SweepRadius)
+			continue;
+
+		FVector Offset;
+		float Height = 0.0f;
+
+		if (!GetSweptOffset(Start, Entry.Start, Entry.Result.HitResult, Offset, Height))
+			continue;
+
+		// the floor distance is clamped when penetrating, it only shifts with the capsule while clear of the floor
+		if (Entry.Result.bBlockingHit && (Entry.Result.FloorDist + Height < 0.0f || (Entry.Result.bLineTrace && Entry.Result.LineDist + Height < 0.0f)))
+			continue;
+
+		OutResult = Entry.Result;
+		OffsetHit(OutResult.HitResult, Offset, Height);
+
+		if (OutResult.bBlockingHit)
+		{
+			OutResult.FloorDist += Height;
+
+			if (OutResult.bLineTrace)
+				OutResult.LineDist += Height;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void FAlphaFloorCache::AddTrace(const FVector& Start, const FHitResult& Hit)
+{
+	if (!IsCacheable(Hit))
+		return;
+
+	const uint32 Key = GetKey(Start);
+	FTraceEntry Entry{ Start, Hit, Key };
+
+	// grows once to its full size instead of reallocating while it fills
+	if (Traces.Num() == 0)
+	{
+		Traces.Reserve(Capacity);
+		TraceIndices.Reserve(Capacity);
+	}
+
+	int32 Index = Traces.Num();
+
+	if (Index < Capacity)
+	{
+		Traces.Add(Entry);
+	}
+	else
+	{
+		Index = NextTrace;
+		NextTrace = (NextTrace + 1) % Capacity;
+
+		// a newer entry may have taken over the key of the one being replaced
+		const int32* OldIndex = TraceIndices.Find(Traces[Index].Key);
+
+		if (OldIndex && *OldIndex == Index)
+			TraceIndices.Remove(Traces[Index].Key);
+
+		Traces[Index] = Entry;
+	}
+
+	TraceIndices.Add(Key, Index);
+}
+
+bool FAlphaFloorCache::FindTrace(const FVector& Start, FHitResult& OutHit) const
+{
+	FCandidates Candidates;
+	FindCandidates(TraceIndices, Start, Candidates);
+
+	for (const int32 Index : Candidates)
+	{
+		const FTraceEntry& Entry = Traces[Index];
+		FVector Offset;
+		float Height = 0.0f;
+
+		if (!GetSweptOffset(Start, Entry.Start, Entry.Hit, Offset, Height))
+			continue;
+
+		OutHit = Entry.Hit;
+		OffsetHit(OutHit, Offset, Height);
+		return true;
+	}
+
+	return false;
+}
+
+void FAlphaFloorCache::Reset()
+{
+	// keeps the allocations, a cleared cache fills up again without growing
+	Floors.Reset();
+	Traces.Reset();
+	FloorIndices.Reset();
+	TraceIndices.Reset();
+	NextFloor = 0;
+	NextTrace = 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+/**
+ * Ring buffer of recent floor queries, so a client replaying saved moves after a correction can reuse the floor it
+ * already found instead of sweeping again.
+ *
+ * A cached result is only reused when the new query sweeps through space the cached one already swept: straight
+ * above or below the cached start, no higher than it, and not past what it hit. A hit where the capsule rests on a
+ * face is also reused from a few units to the side, on the plane of that face. The result is then shifted by the
+ * offset. Only misses or hits on static geometry are cached, anything else may have moved since. Entries are found
+ * through a map keyed by a coarse grid cell of the start and the query size, never by scanning the buffer.
+ */
+class FAlphaFloorCache
+{
+public:
+	explicit FAlphaFloorCache(int32 Capacity = 256);
+
+	void AddFloor(const FVector& Start, float LineDistance, float SweepDistance, float SweepRadius, const FFindFloorResult& Result);
+	bool FindFloor(const FVector& Start, float LineDistance, float SweepDistance, float SweepRadius, FFindFloorResult& OutResult) const;
+
+	void AddTrace(const FVector& Start, const FHitResult& Hit);
+	bool FindTrace(const FVector& Start, FHitResult& OutHit) const;
+
+	void Reset();
+
+private:
+	struct FFloorEntry
+	{
+		FVector Start;
+		float LineDistance;
+		float SweepDistance;
+		float SweepRadius;
+		FFindFloorResult Result;
+		uint32 Key;
+	};
+
+	struct FTraceEntry
+	{
+		FVector Start;
+		FHitResult Hit;
+		uint32 Key;
+	};
+
+	static bool IsCacheable(const FHitResult& Hit);
+	static uint32 GetKey(const FVector& Start, float LineDistance = 0.0f, float SweepDistance = 0.0f, float SweepRadius = 0.0f);
+
+	/**
+	 * Offset of Start from the cached start, and its height above the cached start measured from the floor under it.
+	 * False if a query from Start would leave the cached sweep or land on anything but the cached face.
+	 */
+	static bool GetSweptOffset(const FVector& Start, const FVector& CachedStart, const FHitResult& CachedHit, FVector& OutOffset, float& OutHeight);
+	static void OffsetHit(FHitResult& Hit, const FVector& Offset, float Height);
+
+	/**
+	 * Newest entries of the cells a start within reuse distance of Start is filed under
+	 */
+	using FCandidates = TArray<int32, TInlineAllocator<4>>;
+	static void FindCandidates(const TMap<uint32, int32>& Indices, const FVector& Start, FCandidates& OutCandidates, float LineDistance = 0.0f, float SweepDistance = 0.0f, float SweepRadius = 0.0f);
+
+	TArray<FFloorEntry> Floors;
+	TArray<FTraceEntry> Traces;
+	TMap<uint32, int32> FloorIndices;
+	TMap<uint32, int32> TraceIndices;
+	int32 Capacity;
+	int32 NextFloor;
+	int32 NextTrace;
+};
@@ -0,0 +1,125 @@
+#include "FAlphaMovementCapture.h"
+#include "HAL/FileManager.h"
+
+constexpr uint32 CaptureMagic = 0x43544C41;
+constexpr uint32 CaptureVersion = 1;
+
+static void SerializeSnapshot(FArchive& Ar, FAlphaMovementSnapshot& Snapshot)
+{
+	Ar << Snapshot.Location;
+	Ar << Snapshot.Rotation;
+	Ar << Snapshot.Velocity;
+	Ar << Snapshot.SurfaceFriction;
+	Ar << Snapshot.MaxStepHeight;
+	Ar << Snapshot.WalkableFloorZ;
+	Ar << Snapshot.TimeAccumulator;
+	Ar << Snapshot.Tick;
+	Ar << Snapshot.MovementMode;
+	Ar << Snapshot.CustomMovementMode;
+	Ar << Snapshot.bBrakingFrameTolerated;
+}
+
+static void SerializeTuning(FArchive& Ar, FAlphaVelocityTuning& Tuning)
+{
+	Ar << Tuning.GroundAccelerationModifier;
+	Ar << Tuning.AirAccelerationModifier;
+	Ar << Tuning.AirSpeedCap;
+	Ar << Tuning.AxisSpeedLimit;
+	Ar << Tuning.BrakingFriction;
+	Ar << Tuning.BrakingFrictionFactor;
+	Ar << Tuning.BrakingSubStepTime;
+	Ar << Tuning.MaxWalkSpeedCrouched;
+	Ar << Tuning.MinSlopeSpeedModifier;
+	Ar << Tuning.MaxSlopeSpeedModifier;
+	Ar << Tuning.DefaultStepHeight;
+	Ar << Tuning.MinStepHeight;
+	Ar << Tuning.DefaultWalkableFloorZ;
+	Ar << Tuning.SlidingWalkableFloorZ;
+	Ar << Tuning.bUseSeparateBrakingFriction;
+}
+
+void FAlphaMovementCapture::Serialize(FArchive& Ar)
+{
+	Ar << MapName;
+	Ar << CharacterClass;
+	Ar << TickMs;
+	Ar << DeltaTime;
+
+	SerializeSnapshot(Ar, Before);
+	SerializeSnapshot(Ar, After);
+
+	Ar << InputVector;
+	Ar << ControlRotation;
+	Ar << bPressedJump;
+	Ar << bWantsToCrouch;
+	Ar << bIsCrouched;
+
+	SerializeTuning(Ar, Tuning);
+	Ar << GravityZ;
+	Ar << MaxSpeed;
+
+	Ar << FloorNormal;
+	Ar << FloorDist;
+	Ar << bWalkableFloor;
+
+	int32 NumSweeps = Sweeps.Num();
+	Ar << NumSweeps;
+
+	if (Ar.IsLoading())
+		Sweeps.SetNum(FMath::Max(NumSweeps, 0));
+
+	for (FAlphaCapturedSweep& Sweep : Sweeps)
+	{
+		Ar << Sweep.Start;
+		Ar << Sweep.Delta;
+		Ar << Sweep.ImpactNormal;
+		Ar << Sweep.Time;
+		Ar << Sweep.bBlockingHit;
+	}
+}
+
+bool FAlphaMovementCapture::Save(const FString& Filename) const
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Filename));
+
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaMovementCapture failed to create %s"), *Filename);
+		return false;
+	}
+
+	uint32 Magic = CaptureMagic;
+	uint32 Version = CaptureVersion;
+	*Writer << Magic;
+	*Writer << Version;
+
+	// Serialize is shared with loading, the writer only reads from the capture
+	const_cast<FAlphaMovementCapture*>(this)->Serialize(*Writer);
+
+	return Writer->Close();
+}
+
+bool FAlphaMovementCapture::Load(const FString& Filename)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Filename));
+
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaMovementCapture failed to open %s"), *Filename);
+		return false;
+	}
+
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	*Reader << Magic;
+	*Reader << Version;
+
+	if (Magic != CaptureMagic || Version != CaptureVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaMovementCapture %s is not a version %u capture"), *Filename, CaptureVersion);
+		return false;
+	}
+
+	Serialize(*Reader);
+	return !Reader->IsError();
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "FAlphaMovementSnapshot.h"
+#include "FAlphaVelocityKernel.h"
+
+/**
+ * A move sweep made during a captured tick
+ */
+struct FAlphaCapturedSweep
+{
+	FVector Start = FVector::ZeroVector;
+	FVector Delta = FVector::ZeroVector;
+	FVector ImpactNormal = FVector::ZeroVector;
+	float Time = 1.0f;
+	bool bBlockingHit = false;
+};
+
+/**
+ * One movement tick of one character, with everything needed to run it again: the state and input it started
+ * from, the tuning it ran with, the floor it stood on, the sweeps it made and the state it ended in.
+ *
+ * Written by the slow tick watchdog in UAlphaMovementConfig, replayed by AAlphaLoadTestGameMode (?ReplayCapture=).
+ */
+struct FAlphaMovementCapture
+{
+	FString MapName;
+	FString CharacterClass;
+
+	/**
+	 * Game thread time (in ms) the captured tick took
+	 */
+	float TickMs = 0.0f;
+	float DeltaTime = 0.0f;
+
+	FAlphaMovementSnapshot Before;
+	FAlphaMovementSnapshot After;
+
+	FVector InputVector = FVector::ZeroVector;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	bool bPressedJump = false;
+	bool bWantsToCrouch = false;
+	bool bIsCrouched = false;
+
+	FAlphaVelocityTuning Tuning;
+	float GravityZ = 0.0f;
+	float MaxSpeed = 0.0f;
+
+	/**
+	 * Floor the tick started on
+	 */
+	FVector FloorNormal = FVector::ZeroVector;
+	float FloorDist = 0.0f;
+	bool bWalkableFloor = false;
+
+	TArray<FAlphaCapturedSweep> Sweeps;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	void Serialize(FArchive& Ar);
+};
@@ -0,0 +1,117 @@
+#include "FAlphaMovementCounters.h"
+#include "Misc/ScopeLock.h"
+
+/**
+ * Counters of every live thread, plus what exited threads counted
+ */
+struct FAlphaMovementCounterRegistry
+{
+	FCriticalSection Lock;
+	TArray<const FAlphaMovementCounters*> Threads;
+	FAlphaMovementCounters Retired;
+};
+
+static FAlphaMovementCounterRegistry& GetCounterRegistry()
+{
+	static FAlphaMovementCounterRegistry Registry;
+	return Registry;
+}
+
+struct FAlphaThreadMovementCounters
+{
+	FAlphaMovementCounters Counters;
+
+	FAlphaThreadMovementCounters()
+	{
+		FAlphaMovementCounterRegistry& Registry = GetCounterRegistry();
+		FScopeLock Lock(&Registry.Lock);
+		Registry.Threads.Add(&Counters);
+	}
+
+	~FAlphaThreadMovementCounters()
+	{
+		FAlphaMovementCounterRegistry& Registry = GetCounterRegistry();
+		FScopeLock Lock(&Registry.Lock);
+		Registry.Retired += Counters;
+		Registry.Threads.RemoveSingleSwap(&Counters);
+	}
+};
+
+FAlphaMovementCounters& FAlphaMovementCounters::Get()
+{
+	thread_local FAlphaThreadMovementCounters ThreadCounters;
+	return ThreadCounters.Counters;
+}
+
+FAlphaMovementCounters FAlphaMovementCounters::GetTotal()
+{
+	FAlphaMovementCounterRegistry& Registry = GetCounterRegistry();
+	FScopeLock Lock(&Registry.Lock);
+
+	FAlphaMovementCounters Result = Registry.Retired;
+
+	for (const FAlphaMovementCounters* Counters : Registry.Threads)
+		Result += *Counters;
+
+	return Result;
+}
+
+void FAlphaMovementCounters::AddSpeedSample(float Speed)
+{
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt(Speed / SpeedBucketSize), 0, NumSpeedBuckets - 1);
+	SpeedSamples[Bucket]++;
+	SpeedSum += static_cast<uint64>(FMath::Max(Speed, 0.0f));
+}
+
+FAlphaMovementCounters FAlphaMovementCounters::operator-(const FAlphaMovementCounters& Other) const
+{
+	FAlphaMovementCounters Result;
+	Result.MovementCycles = MovementCycles - Other.MovementCycles;
+	Result.MovementUpdates = MovementUpdates - Other.MovementUpdates;
+	Result.MoveSweeps = MoveSweeps - Other.MoveSweeps;
+	Result.FloorSweeps = FloorSweeps - Other.FloorSweeps;
+	Result.Corrections = Corrections - Other.Corrections;
+	Result.Replays = Replays - Other.Replays;
+	Result.ReplayedMoves = ReplayedMoves - Other.ReplayedMoves;
+	Result.ReplayCycles = ReplayCycles - Other.ReplayCycles;
+	Result.ReplaySweeps = ReplaySweeps - Other.ReplaySweeps;
+	Result.ReplayCacheHits = ReplayCacheHits - Other.ReplayCacheHits;
+	Result.FallingSteps = FallingSteps - Other.FallingSteps;
+	Result.FallingSweeps = FallingSweeps - Other.FallingSweeps;
+	Result.DegradedUpdates = DegradedUpdates - Other.DegradedUpdates;
+	Result.Landings = Landings - Other.Landings;
+	Result.CatchAirs = CatchAirs - Other.CatchAirs;
+	Result.ServerMoveBytes = ServerMoveBytes - Other.ServerMoveBytes;
+	Result.SpeedSum = SpeedSum - Other.SpeedSum;
+
+	for (int32 Bucket = 0; Bucket < NumSpeedBuckets; Bucket++)
+		Result.SpeedSamples[Bucket] = SpeedSamples[Bucket] - Other.SpeedSamples[Bucket];
+
+	return Result;
+}
+
+FAlphaMovementCounters& FAlphaMovementCounters::operator+=(const FAlphaMovementCounters& Other)
+{
+	MovementCycles += Other.MovementCycles;
+	MovementUpdates += Other.MovementUpdates;
+	MoveSweeps += Other.MoveSweeps;
+	FloorSweeps += Other.FloorSweeps;
+	Corrections += Other.Corrections;
+	Replays += Other.Replays;
+	ReplayedMoves += Other.ReplayedMoves;
+	ReplayCycles += Other.ReplayCycles;
+	ReplaySweeps += Other.ReplaySweeps;
+	ReplayCacheHits += Other.ReplayCacheHits;
+	FallingSteps += Other.FallingSteps;
+	FallingSweeps += Other.FallingSweeps;
+	DegradedUpdates += Other.DegradedUpdates;
+	Landings += Other.Landings;
+	CatchAirs += Other.CatchAirs;
+	ServerMoveBytes += Other.ServerMoveBytes;
+	SpeedSum += Other.SpeedSum;
+
+	for (int32 Bucket = 0; Bucket < NumSpeedBuckets; Bucket++)
+		SpeedSamples[Bucket] += Other.SpeedSamples[Bucket];
+
+	return *this;
+}
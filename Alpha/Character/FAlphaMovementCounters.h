@@ -0,0 +1,168 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * One running total. Only the thread owning it adds to it, any other thread may read it at the same time, so every
+ * access is a relaxed atomic and copies read it the same way.
+ */
+struct FAlphaMovementCounter
+{
+	FAlphaMovementCounter(uint64 InValue = 0)
+		: Value(InValue)
+	{
+	}
+
+	FAlphaMovementCounter(const FAlphaMovementCounter& Other)
+		: Value(Other.Load())
+	{
+	}
+
+	FAlphaMovementCounter& operator=(const FAlphaMovementCounter& Other)
+	{
+		Value.store(Other.Load(), std::memory_order_relaxed);
+		return *this;
+	}
+
+	FAlphaMovementCounter& operator+=(uint64 Amount)
+	{
+		Value.fetch_add(Amount, std::memory_order_relaxed);
+		return *this;
+	}
+
+	FAlphaMovementCounter& operator++()
+	{
+		return *this += 1;
+	}
+
+	void operator++(int)
+	{
+		*this += 1;
+	}
+
+	uint64 Load() const
+	{
+		return Value.load(std::memory_order_relaxed);
+	}
+
+	operator uint64() const
+	{
+		return Load();
+	}
+
+private:
+	std::atomic<uint64> Value;
+};
+
+/**
+ * Running totals of the work done by every UAlphaMovementConfig, sampled by profiling tools such as the load test.
+ *
+ * Every thread counts into its own instance so counting never contends, readers merge them with GetTotal. The
+ * counters are atomics so reading another thread's instance while it counts is not a data race.
+ */
+struct FAlphaMovementCounters
+{
+	/**
+	 * Speed histogram buckets (unit/s), the last bucket holds everything faster
+	 */
+	static constexpr int32 NumSpeedBuckets = 16;
+	static constexpr float SpeedBucketSize = 250.0f;
+
+	/**
+	 * Cycles spent simulating movement, both ticks and received server moves
+	 */
+	FAlphaMovementCounter MovementCycles;
+
+	/**
+	 * Number of movement updates simulated
+	 */
+	FAlphaMovementCounter MovementUpdates;
+
+	/**
+	 * Number of sweeps done while moving the updated component
+	 */
+	FAlphaMovementCounter MoveSweeps;
+
+	/**
+	 * Number of sweeps done while looking for or tracing the floor
+	 */
+	FAlphaMovementCounter FloorSweeps;
+
+	/**
+	 * Number of client moves the server had to correct
+	 */
+	FAlphaMovementCounter Corrections;
+
+	/**
+	 * Number of times a client replayed its saved moves after a correction
+	 */
+	FAlphaMovementCounter Replays;
+
+	/**
+	 * Saved moves replayed after corrections
+	 */
+	FAlphaMovementCounter ReplayedMoves;
+
+	/**
+	 * Cycles spent replaying saved moves
+	 */
+	FAlphaMovementCounter ReplayCycles;
+
+	/**
+	 * Floor sweeps done while replaying, not counting ones answered by the floor cache
+	 */
+	FAlphaMovementCounter ReplaySweeps;
+
+	/**
+	 * Floor queries answered by the floor cache while replaying
+	 */
+	FAlphaMovementCounter ReplayCacheHits;
+
+	/**
+	 * Falling simulation steps
+	 */
+	FAlphaMovementCounter FallingSteps;
+
+	/**
+	 * Sweeps done while moving in falling steps, a subset of MoveSweeps
+	 */
+	FAlphaMovementCounter FallingSweeps;
+
+	/**
+	 * Movement updates run below full fidelity by the movement budget
+	 */
+	FAlphaMovementCounter DegradedUpdates;
+
+	/**
+	 * Landings and catch airs, not counting client replays
+	 */
+	FAlphaMovementCounter Landings;
+	FAlphaMovementCounter CatchAirs;
+
+	/**
+	 * Bytes of packed client moves received by the server
+	 */
+	FAlphaMovementCounter ServerMoveBytes;
+
+	/**
+	 * Speed of every movement update, bucketed by SpeedBucketSize
+	 */
+	FAlphaMovementCounter SpeedSamples[NumSpeedBuckets];
+	FAlphaMovementCounter SpeedSum;
+
+	void AddSpeedSample(float Speed);
+
+	/**
+	 * Returns the calling thread's counters, only ever add to them
+	 */
+	static FAlphaMovementCounters& Get();
+
+	/**
+	 * Sums the counters of every thread, including threads which have exited. Safe from any thread, values counted
+	 * while summing may land in this total or the next one, each counter is read whole
+	 */
+	static FAlphaMovementCounters GetTotal();
+
+	FAlphaMovementCounters operator-(const FAlphaMovementCounters& Other) const;
+	FAlphaMovementCounters& operator+=(const FAlphaMovementCounters& Other);
+};
@@ -0,0 +1,53 @@
+#include "FAlphaMovementSnapshot.h"
+#include "Misc/Crc.h"
+
+const float QUANTIZE_SCALE = 64.0f;
+
+uint32 FAlphaMovementSnapshot::GetStateHash() const
+{
+	// packed field by field so padding and the in memory vector precision don't leak into the hash
+	TArray<uint8, TInlineAllocator<96>> Bytes;
+
+	auto Append = [&Bytes](const void* Data, int32 Size)
+	{
+		Bytes.Append(static_cast<const uint8*>(Data), Size);
+	};
+
+	auto AppendFloat = [&Append](double Value)
+	{
+		const float Single = static_cast<float>(Value);
+		Append(&Single, sizeof(Single));
+	};
+
+	AppendFloat(Location.X);
+	AppendFloat(Location.Y);
+	AppendFloat(Location.Z);
+	AppendFloat(Rotation.X);
+	AppendFloat(Rotation.Y);
+	AppendFloat(Rotation.Z);
+	AppendFloat(Rotation.W);
+	AppendFloat(Velocity.X);
+	AppendFloat(Velocity.Y);
+	AppendFloat(Velocity.Z);
+	AppendFloat(SurfaceFriction);
+	AppendFloat(MaxStepHeight);
+	AppendFloat(WalkableFloorZ);
+	AppendFloat(TimeAccumulator);
+	Append(&Tick, sizeof(Tick));
+	Append(&MovementMode, sizeof(MovementMode));
+	Append(&CustomMovementMode, sizeof(CustomMovementMode));
+
+	const uint8 BrakingFrameTolerated = bBrakingFrameTolerated ? 1 : 0;
+	Append(&BrakingFrameTolerated, sizeof(BrakingFrameTolerated));
+
+	return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+}
+
+FVector FAlphaMovementSnapshot::Quantize(const FVector& Value)
+{
+	return FVector(
+		FMath::RoundToFloat(Value.X * QUANTIZE_SCALE) / QUANTIZE_SCALE,
+		FMath::RoundToFloat(Value.Y * QUANTIZE_SCALE) / QUANTIZE_SCALE,
+		FMath::RoundToFloat(Value.Z * QUANTIZE_SCALE) / QUANTIZE_SCALE
+	);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Everything UAlphaMovementConfig needs to resimulate deterministically from a given tick
+ */
+struct FAlphaMovementSnapshot
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector Velocity = FVector::ZeroVector;
+	float SurfaceFriction = 1.0f;
+	float MaxStepHeight = 0.0f;
+	float WalkableFloorZ = 0.0f;
+	float TimeAccumulator = 0.0f;
+	uint32 Tick = 0;
+	uint8 MovementMode = 0;
+	uint8 CustomMovementMode = 0;
+	bool bBrakingFrameTolerated = false;
+
+	/**
+	 * CRC of the state, used to compare a resimulation against the authority
+	 */
+	uint32 GetStateHash() const;
+
+	/**
+	 * Snaps to the grid deterministic steps end on
+	 */
+	static FVector Quantize(const FVector& Value);
+};
@@ -0,0 +1,120 @@
+#include "FAlphaProxySmoother.h"
+
+// fraction of each new measurement blended into the interval, jitter and clock estimates
+const float ESTIMATE_SMOOTHING = 0.1f;
+// how far (in seconds) past the newest snapshot a proxy keeps moving before it waits
+const float MAX_EXTRAPOLATION_TIME = 0.1f;
+
+FAlphaProxySmoother::FAlphaProxySmoother()
+{
+	Newest = 0;
+	Count = 0;
+	ClockOffset = 0.0f;
+	Interval = 0.0f;
+	Jitter = 0.0f;
+	Delay = 0.1f;
+}
+
+bool FAlphaProxySmoother::AddSnapshot(float ServerTime, float LocalTime, const FVector& Location, const FVector& Velocity, const FQuat& Rotation, float MaxError)
+{
+	bool bContinuous = true;
+
+	if (Count > 0)
+	{
+		FSnapshot& Latest = Snapshots[Newest];
+
+		// out of order, or a second update within the same server frame
+		if (ServerTime <= Latest.Time)
+		{
+			if (ServerTime == Latest.Time)
+				Latest = { ServerTime, Location, Velocity, Rotation };
+
+			return true;
+		}
+
+		FQuat PredictedRotation;
+		const FVector Predicted = Sample(ServerTime, PredictedRotation);
+
+		// teleported, interpolating towards it would drag the proxy across the map
+		if (FVector::DistSquared(Predicted, Location) > FMath::Square(MaxError))
+		{
+			Count = 0;
+			bContinuous = false;
+		}
+	}
+
+	const float RawOffset = ServerTime - LocalTime;
+
+	if (Count == 0)
+	{
+		ClockOffset = RawOffset;
+	}
+	else
+	{
+		const float NewInterval = ServerTime - Snapshots[Newest].Time;
+
+		Interval = Interval > 0.0f ? FMath::Lerp(Interval, NewInterval, ESTIMATE_SMOOTHING) : NewInterval;
+		Jitter = FMath::Lerp(Jitter, FMath::Abs(RawOffset - ClockOffset), ESTIMATE_SMOOTHING);
+		ClockOffset = FMath::Lerp(ClockOffset, RawOffset, ESTIMATE_SMOOTHING);
+	}
+
+	Newest = (Newest + 1) % NUM_SNAPSHOTS;
+	Snapshots[Newest] = { ServerTime, Location, Velocity, Rotation };
+	Count = FMath::Min(Count + 1, NUM_SNAPSHOTS);
+
+	return bContinuous;
+}
+
+FVector FAlphaProxySmoother::Sample(float ServerTime, FQuat& OutRotation) const
+{
+	const FSnapshot& Latest = GetSnapshot(0);
+
+	if (ServerTime >= Latest.Time)
+	{
+		OutRotation = Latest.Rotation;
+		return Latest.Location + Latest.Velocity * FMath::Min(ServerTime - Latest.Time, MAX_EXTRAPOLATION_TIME);
+	}
+
+	for (int32 Age = 1; Age < Count; Age++)
+	{
+		const FSnapshot& From = GetSnapshot(Age);
+
+		if (ServerTime < From.Time)
+			continue;
+
+		const FSnapshot& To = GetSnapshot(Age - 1);
+		const float Span = To.Time - From.Time;
+		const float Alpha = (ServerTime - From.Time) / Span;
+
+		// velocities are per second, tangents are per span
+		OutRotation = FQuat::Slerp(From.Rotation, To.Rotation, Alpha);
+		return FMath::CubicInterp(From.Location, From.Velocity * Span, To.Location, To.Velocity * Span, Alpha);
+	}
+
+	const FSnapshot& Oldest = GetSnapshot(Count - 1);
+	OutRotation = Oldest.Rotation;
+	return Oldest.Location;
+}
+
+bool FAlphaProxySmoother::Evaluate(float LocalTime, FVector& OutLocation, FQuat& OutRotation) const
+{
+	if (Count == 0)
+		return false;
+
+	OutLocation = Sample(GetServerTime(LocalTime) - Delay, OutRotation);
+	return true;
+}
+
+void FAlphaProxySmoother::UpdateDelay(float DeltaTime, float MinDelay, float MaxDelay)
+{
+	const float TargetDelay = FMath::Clamp(Interval + 2.0f * Jitter, MinDelay, FMath::Max(MinDelay, MaxDelay));
+	Delay = FMath::FInterpTo(Delay, TargetDelay, DeltaTime, 2.0f);
+}
+
+void FAlphaProxySmoother::Reset()
+{
+	Newest = 0;
+	Count = 0;
+	Interval = 0.0f;
+	Jitter = 0.0f;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Smooths simulated proxies by interpolating through the last few replicated states with cubic Hermite curves,
+ * using the replicated velocities as tangents so fast curved paths (surfing, strafing) stay on the arc.
+ *
+ * Snapshots are stamped with the server time of the update, rendering runs a delay behind the estimated server
+ * clock. The delay follows the update interval plus twice the measured arrival jitter. Storage is a fixed ring,
+ * evaluating costs one short scan and one curve.
+ */
+class FAlphaProxySmoother
+{
+public:
+	static constexpr int32 NUM_SNAPSHOTS = 8;
+
+	FAlphaProxySmoother();
+
+	/**
+	 * @param ServerTime Server time the state was sent at
+	 * @param LocalTime Local time it arrived at
+	 * @return False if the state was too far from the buffered path and the buffer restarted from it
+	 */
+	bool AddSnapshot(float ServerTime, float LocalTime, const FVector& Location, const FVector& Velocity, const FQuat& Rotation, float MaxError);
+
+	/**
+	 * Returns the state to render at a local time
+	 * @return False if there is nothing to render yet
+	 */
+	bool Evaluate(float LocalTime, FVector& OutLocation, FQuat& OutRotation) const;
+
+	/**
+	 * Moves the render delay towards its target, called once per frame
+	 */
+	void UpdateDelay(float DeltaTime, float MinDelay, float MaxDelay);
+
+	float GetDelay() const
+	{
+		return Delay;
+	}
+
+	float GetJitter() const
+	{
+		return Jitter;
+	}
+
+	void Reset();
+
+private:
+	struct FSnapshot
+	{
+		float Time;
+		FVector Location;
+		FVector Velocity;
+		FQuat Rotation;
+	};
+
+	const FSnapshot& GetSnapshot(int32 Age) const
+	{
+		return Snapshots[(Newest - Age + NUM_SNAPSHOTS) % NUM_SNAPSHOTS];
+	}
+
+	/**
+	 * Server time at a local time, without the render delay
+	 */
+	float GetServerTime(float LocalTime) const
+	{
+		return LocalTime + ClockOffset;
+	}
+
+	FVector Sample(float ServerTime, FQuat& OutRotation) const;
+
+	FSnapshot Snapshots[NUM_SNAPSHOTS];
+	int32 Newest;
+	int32 Count;
+
+	float ClockOffset;
+	float Interval;
+	float Jitter;
+	float Delay;
+};
@@ -0,0 +1,283 @@
+#include "FAlphaTrajectory.h"
+#include "Alpha/Alpha.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "WorldCollision.h"
+
+DECLARE_CYCLE_STAT(TEXT("Predict Landings"), STAT_AlphaPredictLandings, STATGROUP_AlphaMovement);
+
+/**
+ * Applies the per axis clamp done by CalcVelocity and NewFallVelocity
+ */
+static FVector ClampToAxisSpeedLimit(const FVector& Velocity, float AxisSpeedLimit)
+{
+	return FVector(
+		FMath::Clamp(Velocity.X, -AxisSpeedLimit, AxisSpeedLimit),
+		FMath::Clamp(Velocity.Y, -AxisSpeedLimit, AxisSpeedLimit),
+		FMath::Clamp(Velocity.Z, -AxisSpeedLimit, AxisSpeedLimit)
+	);
+}
+
+/**
+ * Returns the strafe acceleration along the wish direction and how long it lasts before hitting the air speed cap
+ */
+static float GetStrafeAcceleration(const FAlphaTrajectoryParams& Params, const FVector& WishDirection, const FVector& Velocity, float& OutStrafeTime)
+{
+	OutStrafeTime = 0.0f;
+
+	if (Params.AirAcceleration <= 0.0f || WishDirection.IsNearlyZero())
+		return 0.0f;
+
+	const float Veer = Velocity.X * WishDirection.X + Velocity.Y * WishDirection.Y;
+	OutStrafeTime = FMath::Max(0.0f, (Params.AirSpeedCap - Veer) / Params.AirAcceleration);
+
+	return Params.AirAcceleration;
+}
+
+/**
+ * Returns the time it takes to reach terminal velocity, velocity must already be clamped
+ */
+static float GetTerminalTime(const FAlphaTrajectoryParams& Params, float VelocityZ)
+{
+	if (Params.GravityZ >= 0.0f)
+		return BIG_NUMBER;
+
+	return (-Params.AxisSpeedLimit - VelocityZ) / Params.GravityZ;
+}
+
+static float GetFallDistance(const FAlphaTrajectoryParams& Params, float VelocityZ, float Time)
+{
+	const float TerminalTime = GetTerminalTime(Params, VelocityZ);
+
+	if (Time <= TerminalTime)
+		return VelocityZ * Time + 0.5f * Params.GravityZ * Time * Time;
+
+	return VelocityZ * TerminalTime + 0.5f * Params.GravityZ * TerminalTime * TerminalTime - Params.AxisSpeedLimit * (Time - TerminalTime);
+}
+
+FVector FAlphaTrajectory::EvaluatePosition(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Time)
+{
+	const FVector Velocity = ClampToAxisSpeedLimit(Candidate.Velocity, Params.AxisSpeedLimit);
+
+	float StrafeTime;
+	const float StrafeAcceleration = GetStrafeAcceleration(Params, Candidate.WishDirection, Velocity, StrafeTime);
+	const float ClampedStrafeTime = FMath::Min(Time, StrafeTime);
+	const float Strafe = StrafeAcceleration * ClampedStrafeTime * (Time - 0.5f * ClampedStrafeTime);
+
+	return FVector(
+		Candidate.Origin.X + Velocity.X * Time + Candidate.WishDirection.X * Strafe,
+		Candidate.Origin.Y + Velocity.Y * Time + Candidate.WishDirection.Y * Strafe,
+		Candidate.Origin.Z + GetFallDistance(Params, Velocity.Z, Time)
+	);
+}
+
+FVector FAlphaTrajectory::EvaluateVelocity(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Time)
+{
+	const FVector Velocity = ClampToAxisSpeedLimit(Candidate.Velocity, Params.AxisSpeedLimit);
+
+	float StrafeTime;
+	const float StrafeAcceleration = GetStrafeAcceleration(Params, Candidate.WishDirection, Velocity, StrafeTime);
+	const float StrafeSpeed = StrafeAcceleration * FMath::Min(Time, StrafeTime);
+
+	return FVector(
+		Velocity.X + Candidate.WishDirection.X * StrafeSpeed,
+		Velocity.Y + Candidate.WishDirection.Y * StrafeSpeed,
+		FMath::Clamp(Velocity.Z + Params.GravityZ * Time, -Params.AxisSpeedLimit, Params.AxisSpeedLimit)
+	);
+}
+
+float FAlphaTrajectory::SolveTimeToHeight(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Z)
+{
+	if (Params.GravityZ >= 0.0f || Params.AxisSpeedLimit <= KINDA_SMALL_NUMBER)
+		return -1.0f;
+
+	const float VelocityZ = FMath::Clamp(Candidate.Velocity.Z, -Params.AxisSpeedLimit, Params.AxisSpeedLimit);
+	const float Height = Candidate.Origin.Z - Params.CapsuleHalfHeight - Z;
+	const float Discriminant = VelocityZ * VelocityZ - 2.0f * Params.GravityZ * Height;
+
+	if (Discriminant < 0.0f)
+		return -1.0f;
+
+	// descending root of the parabola
+	float Time = (-VelocityZ - FMath::Sqrt(Discriminant)) / Params.GravityZ;
+	const float TerminalTime = GetTerminalTime(Params, VelocityZ);
+
+	// crossed after reaching terminal velocity, fall the rest of the way linearly
+	if (Time > TerminalTime)
+	{
+		const float TerminalHeight = Height + VelocityZ * TerminalTime + 0.5f * Params.GravityZ * TerminalTime * TerminalTime;
+		Time = TerminalTime + TerminalHeight / Params.AxisSpeedLimit;
+	}
+
+	return Time >= 0.0f ? Time : -1.0f;
+}
+
+FAlphaLandingPrediction FAlphaTrajectory::PredictLanding(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime)
+{
+	FAlphaLandingPrediction Prediction;
+	Prediction.Time = MaxTime;
+
+	for (int32 SurfaceIndex = 0; SurfaceIndex < Surfaces.Num(); SurfaceIndex++)
+	{
+		const FAlphaLandingSurface& Surface = Surfaces[SurfaceIndex];
+		const float Time = SolveTimeToHeight(Params, Candidate, Surface.Z);
+
+		if (Time < 0.0f || Time > Prediction.Time)
+			continue;
+
+		const FVector Location = EvaluatePosition(Params, Candidate, Time);
+
+		if (!Surface.Bounds.ExpandBy(Params.CapsuleRadius).IsInside(FVector2D(Location)))
+			continue;
+
+		Prediction.Time = Time;
+		Prediction.SurfaceIndex = SurfaceIndex;
+	}
+
+	Prediction.Location = EvaluatePosition(Params, Candidate, Prediction.Time);
+	Prediction.Velocity = EvaluateVelocity(Params, Candidate, Prediction.Time);
+
+	return Prediction;
+}
+
+void FAlphaTrajectory::PredictLandings(const FAlphaTrajectoryParams& Params, TArrayView<const FAlphaTrajectoryCandidate> Candidates, TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime, TArrayView<FAlphaLandingPrediction> OutPredictions)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AlphaPredictLandings);
+	check(OutPredictions.Num() >= Candidates.Num());
+
+	const int32 NumCandidates = Candidates.Num();
+	const bool bCanVectorize = Params.GravityZ < 0.0f && Params.AxisSpeedLimit > KINDA_SMALL_NUMBER;
+	const int32 NumVectorized = bCanVectorize ? (NumCandidates & ~3) : 0;
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float Gravity = VectorSetFloat1(Params.GravityZ);
+	const VectorRegister4Float HalfGravity = VectorSetFloat1(0.5f * Params.GravityZ);
+	const VectorRegister4Float TwoGravity = VectorSetFloat1(2.0f * Params.GravityZ);
+	const VectorRegister4Float SpeedLimit = VectorSetFloat1(Params.AxisSpeedLimit);
+	const VectorRegister4Float InvSpeedLimit = VectorSetFloat1(1.0f / FMath::Max(Params.AxisSpeedLimit, KINDA_SMALL_NUMBER));
+
+	for (int32 Base = 0; Base < NumVectorized; Base += 4)
+	{
+		// transpose into lanes
+		alignas(16) float PX[4], PY[4], PZ[4], VX[4], VY[4], VZ[4], DX[4], DY[4], A[4], TS[4];
+
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FAlphaTrajectoryCandidate& Candidate = Candidates[Base + Lane];
+			const FVector Velocity = ClampToAxisSpeedLimit(Candidate.Velocity, Params.AxisSpeedLimit);
+
+			PX[Lane] = Candidate.Origin.X;
+			PY[Lane] = Candidate.Origin.Y;
+			PZ[Lane] = Candidate.Origin.Z - Params.CapsuleHalfHeight;
+			VX[Lane] = Velocity.X;
+			VY[Lane] = Velocity.Y;
+			VZ[Lane] = Velocity.Z;
+			DX[Lane] = Candidate.WishDirection.X;
+			DY[Lane] = Candidate.WishDirection.Y;
+			A[Lane] = GetStrafeAcceleration(Params, Candidate.WishDirection, Velocity, TS[Lane]);
+		}
+
+		const VectorRegister4Float PosX = VectorLoadAligned(PX);
+		const VectorRegister4Float PosY = VectorLoadAligned(PY);
+		const VectorRegister4Float PosZ = VectorLoadAligned(PZ);
+		const VectorRegister4Float VelX = VectorLoadAligned(VX);
+		const VectorRegister4Float VelY = VectorLoadAligned(VY);
+		const VectorRegister4Float VelZ = VectorLoadAligned(VZ);
+		const VectorRegister4Float WishX = VectorLoadAligned(DX);
+		const VectorRegister4Float WishY = VectorLoadAligned(DY);
+		const VectorRegister4Float StrafeAccel = VectorLoadAligned(A);
+		const VectorRegister4Float StrafeTime = VectorLoadAligned(TS);
+
+		// time and distance until terminal velocity, shared by every surface
+		const VectorRegister4Float TerminalTime = VectorDivide(VectorNegate(VectorAdd(SpeedLimit, VelZ)), Gravity);
+		const VectorRegister4Float TerminalFall = VectorMultiplyAdd(VectorMultiply(HalfGravity, TerminalTime), TerminalTime, VectorMultiply(VelZ, TerminalTime));
+		const VectorRegister4Float VelZSquared = VectorMultiply(VelZ, VelZ);
+
+		VectorRegister4Float BestTime = VectorSetFloat1(MaxTime);
+		VectorRegister4Float BestSurface = VectorSetFloat1(-1.0f);
+
+		for (int32 SurfaceIndex = 0; SurfaceIndex < Surfaces.Num(); SurfaceIndex++)
+		{
+			const FAlphaLandingSurface& Surface = Surfaces[SurfaceIndex];
+			const VectorRegister4Float Height = VectorSubtract(PosZ, VectorSetFloat1(Surface.Z));
+			const VectorRegister4Float Discriminant = VectorSubtract(VelZSquared, VectorMultiply(TwoGravity, Height));
+
+			VectorRegister4Float Valid = VectorCompareGE(Discriminant, Zero);
+
+			const VectorRegister4Float Root = VectorSqrt(VectorMax(Discriminant, Zero));
+			const VectorRegister4Float ParabolaTime = VectorDivide(VectorSubtract(VectorNegate(VelZ), Root), Gravity);
+			const VectorRegister4Float LinearTime = VectorMultiplyAdd(VectorAdd(Height, TerminalFall), InvSpeedLimit, TerminalTime);
+			const VectorRegister4Float Time = VectorSelect(VectorCompareGT(ParabolaTime, TerminalTime), LinearTime, ParabolaTime);
+
+			Valid = VectorBitwiseAnd(Valid, VectorCompareGE(Time, Zero));
+			Valid = VectorBitwiseAnd(Valid, VectorCompareLE(Time, BestTime));
+
+			if (!VectorMaskBits(Valid))
+				continue;
+
+			const VectorRegister4Float ClampedStrafeTime = VectorMin(Time, StrafeTime);
+			const VectorRegister4Float Strafe = VectorMultiply(VectorMultiply(StrafeAccel, ClampedStrafeTime), VectorSubtract(Time, VectorMultiply(Half, ClampedStrafeTime)));
+			const VectorRegister4Float X = VectorMultiplyAdd(WishX, Strafe, VectorMultiplyAdd(VelX, Time, PosX));
+			const VectorRegister4Float Y = VectorMultiplyAdd(WishY, Strafe, VectorMultiplyAdd(VelY, Time, PosY));
+
+			const FBox2D Bounds = Surface.Bounds.ExpandBy(Params.CapsuleRadius);
+			Valid = VectorBitwiseAnd(Valid, VectorCompareGE(X, VectorSetFloat1(Bounds.Min.X)));
+			Valid = VectorBitwiseAnd(Valid, VectorCompareLE(X, VectorSetFloat1(Bounds.Max.X)));
+			Valid = VectorBitwiseAnd(Valid, VectorCompareGE(Y, VectorSetFloat1(Bounds.Min.Y)));
+			Valid = VectorBitwiseAnd(Valid, VectorCompareLE(Y, VectorSetFloat1(Bounds.Max.Y)));
+
+			BestTime = VectorSelect(Valid, Time, BestTime);
+			BestSurface = VectorSelect(Valid, VectorSetFloat1(static_cast<float>(SurfaceIndex)), BestSurface);
+		}
+
+		alignas(16) float Times[4], SurfaceIndices[4];
+		VectorStoreAligned(BestTime, Times);
+		VectorStoreAligned(BestSurface, SurfaceIndices);
+
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FAlphaTrajectoryCandidate& Candidate = Candidates[Base + Lane];
+			FAlphaLandingPrediction& Prediction = OutPredictions[Base + Lane];
+
+			Prediction.Time = Times[Lane];
+			Prediction.SurfaceIndex = SurfaceIndices[Lane] < 0.0f ? INDEX_NONE : FMath::RoundToInt(SurfaceIndices[Lane]);
+			Prediction.Location = EvaluatePosition(Params, Candidate, Prediction.Time);
+			Prediction.Velocity = EvaluateVelocity(Params, Candidate, Prediction.Time);
+		}
+	}
+
+	// leftovers which don't fill a full register
+	for (int32 Index = NumVectorized; Index < NumCandidates; Index++)
+	{
+		OutPredictions[Index] = PredictLanding(Params, Candidates[Index], Surfaces, MaxTime);
+	}
+}
+
+void FAlphaTrajectory::GatherLandingSurfaces(const UWorld* World, const FBox& Region, TArray<FAlphaLandingSurface>& OutSurfaces)
+{
+	if (World == nullptr)
+		return;
+
+	TArray<FOverlapResult> Overlaps;
+	const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AlphaGatherLandingSurfaces), false);
+
+	World->OverlapMultiByObjectType(Overlaps, Region.GetCenter(), FQuat::Identity, ObjectParams, FCollisionShape::MakeBox(Region.GetExtent()), QueryParams);
+
+	OutSurfaces.Reserve(OutSurfaces.Num() + Overlaps.Num());
+
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		const UPrimitiveComponent* Component = Overlap.GetComponent();
+
+		if (Component == nullptr)
+			continue;
+
+		const FBox Bounds = Component->Bounds.GetBox();
+
+		FAlphaLandingSurface& Surface = OutSurfaces.AddDefaulted_GetRef();
+		Surface.Bounds = FBox2D(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+		Surface.Z = Bounds.Max.Z;
+	}
+}
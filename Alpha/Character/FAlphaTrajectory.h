@@ -0,0 +1,114 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Movement tuning needed to solve a falling arc in closed form
+ */
+struct FAlphaTrajectoryParams
+{
+	/**
+	 * Gravity (unit/s^2), negative is down
+	 */
+	float GravityZ = 0.0f;
+
+	/**
+	 * Max speed allowed on any given axis, also used as terminal fall velocity
+	 */
+	float AxisSpeedLimit = 0.0f;
+
+	/**
+	 * Max speed which air strafing can add along the wish direction
+	 */
+	float AirSpeedCap = 0.0f;
+
+	/**
+	 * Acceleration (unit/s^2) applied along the wish direction while in the air
+	 */
+	float AirAcceleration = 0.0f;
+
+	/**
+	 * Capsule size used to test the base of the capsule against landing surfaces
+	 */
+	float CapsuleRadius = 0.0f;
+	float CapsuleHalfHeight = 0.0f;
+};
+
+/**
+ * A trajectory to evaluate, starting from the capsule center
+ */
+struct FAlphaTrajectoryCandidate
+{
+	FVector Origin = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+
+	/**
+	 * Normalized 2D direction the player strafes towards, zero for no input
+	 */
+	FVector WishDirection = FVector::ZeroVector;
+};
+
+/**
+ * Coarse collision used for landing tests, the flat top of a piece of geometry
+ */
+struct FAlphaLandingSurface
+{
+	FBox2D Bounds = FBox2D(ForceInit);
+	float Z = 0.0f;
+};
+
+/**
+ * Where and when a trajectory lands
+ */
+struct FAlphaLandingPrediction
+{
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	float Time = 0.0f;
+	int32 SurfaceIndex = INDEX_NONE;
+
+	bool IsValid() const
+	{
+		return SurfaceIndex != INDEX_NONE;
+	}
+};
+
+/**
+ * Closed form solver for the falling model used by UAlphaMovementConfig::PhysFalling.
+ *
+ * Vertical velocity follows gravity until it is clamped to AxisSpeedLimit, horizontal velocity is only changed
+ * by air strafing along the wish direction until it reaches AirSpeedCap (falling lateral friction is zero).
+ */
+class FAlphaTrajectory
+{
+public:
+	/**
+	 * Returns the capsule center of a trajectory at the given time
+	 */
+	static FVector EvaluatePosition(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Time);
+
+	/**
+	 * Returns the velocity of a trajectory at the given time
+	 */
+	static FVector EvaluateVelocity(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Time);
+
+	/**
+	 * Returns the time the base of the capsule falls through the given height, or a negative value if it never does
+	 */
+	static float SolveTimeToHeight(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, float Z);
+
+	/**
+	 * Finds the first surface a single trajectory lands on within MaxTime
+	 */
+	static FAlphaLandingPrediction PredictLanding(const FAlphaTrajectoryParams& Params, const FAlphaTrajectoryCandidate& Candidate, TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime);
+
+	/**
+	 * Finds the first surface each trajectory lands on within MaxTime, four trajectories at a time
+	 * @param OutPredictions Must be at least as large as Candidates
+	 */
+	static void PredictLandings(const FAlphaTrajectoryParams& Params, TArrayView<const FAlphaTrajectoryCandidate> Candidates, TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime, TArrayView<FAlphaLandingPrediction> OutPredictions);
+
+	/**
+	 * Builds coarse landing surfaces from the bounds of static geometry inside a region
+	 */
+	static void GatherLandingSurfaces(const UWorld* World, const FBox& Region, TArray<FAlphaLandingSurface>& OutSurfaces);
+};
@@ -0,0 +1,158 @@
+#include "FAlphaVelocityKernel.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+bool FAlphaVelocityTuning::Matches(const FAlphaVelocityTuning& Other) const
+{
+	return GroundAccelerationModifier == Other.GroundAccelerationModifier
+		&& AirAccelerationModifier == Other.AirAccelerationModifier
+		&& AirSpeedCap == Other.AirSpeedCap
+		&& AxisSpeedLimit == Other.AxisSpeedLimit
+		&& BrakingFriction == Other.BrakingFriction
+		&& BrakingFrictionFactor == Other.BrakingFrictionFactor
+		&& BrakingSubStepTime == Other.BrakingSubStepTime
+		&& MaxWalkSpeedCrouched == Other.MaxWalkSpeedCrouched
+		&& MinSlopeSpeedModifier == Other.MinSlopeSpeedModifier
+		&& MaxSlopeSpeedModifier == Other.MaxSlopeSpeedModifier
+		&& DefaultStepHeight == Other.DefaultStepHeight
+		&& MinStepHeight == Other.MinStepHeight
+		&& DefaultWalkableFloorZ == Other.DefaultWalkableFloorZ
+		&& SlidingWalkableFloorZ == Other.SlidingWalkableFloorZ
+		&& bUseSeparateBrakingFriction == Other.bUseSeparateBrakingFriction;
+}
+
+bool FAlphaVelocityInput::Matches(const FAlphaVelocityInput& Other) const
+{
+	return Velocity == Other.Velocity
+		&& Acceleration == Other.Acceleration
+		&& DeltaTime == Other.DeltaTime
+		&& Friction == Other.Friction
+		&& BrakingDeceleration == Other.BrakingDeceleration
+		&& MaxSpeed == Other.MaxSpeed
+		&& SurfaceFriction == Other.SurfaceFriction
+		&& bFluid == Other.bFluid
+		&& bGroundMove == Other.bGroundMove
+		&& bFalling == Other.bFalling;
+}
+
+void FAlphaVelocityKernel::Calculate(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output)
+{
+	Output.Acceleration = Input.Acceleration;
+	Output.Velocity = ApplyInputAcceleration(Tuning, Input, ApplyFriction(Tuning, Input), Output.Acceleration);
+	ApplySpeedLimits(Tuning, Input, Output);
+}
+
+FVector FAlphaVelocityKernel::ApplyFriction(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input)
+{
+	FVector Velocity = Input.Velocity;
+
+	if (Input.bGroundMove)
+	{
+		// same 1% tolerance as UMovementComponent::IsExceedingMaxSpeed
+		const bool bVelocityOverMax = Velocity.SizeSquared() > FMath::Square(FMath::Max(Input.MaxSpeed, 0.0f)) * 1.01f;
+		const FVector OldVelocity = Velocity;
+
+		const float ActualBrakingFriction = (Tuning.bUseSeparateBrakingFriction ? Tuning.BrakingFriction : Input.Friction) * Input.SurfaceFriction;
+		Velocity = ApplyBraking(Tuning, Velocity, Input.DeltaTime, ActualBrakingFriction, Input.BrakingDeceleration);
+
+		// Don't allow braking to lower us below max speed if we started above it.
+		if (bVelocityOverMax && Velocity.SizeSquared() < FMath::Square(Input.MaxSpeed) && FVector::DotProduct(Input.Acceleration, OldVelocity) > 0.0f)
+			Velocity = OldVelocity.GetSafeNormal() * Input.MaxSpeed;
+	}
+
+	if (Input.bFluid)
+		Velocity = Velocity * (1.0f - FMath::Min(Input.Friction * Input.DeltaTime, 1.0f));
+
+	Velocity.X = FMath::Clamp(Velocity.X, -Tuning.AxisSpeedLimit, Tuning.AxisSpeedLimit);
+	Velocity.Y = FMath::Clamp(Velocity.Y, -Tuning.AxisSpeedLimit, Tuning.AxisSpeedLimit);
+
+	return Velocity;
+}
+
+FVector FAlphaVelocityKernel::ApplyInputAcceleration(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, const FVector& Velocity, FVector& InOutAcceleration)
+{
+	if (InOutAcceleration.IsNearlyZero())
+		return Velocity;
+
+	// Clamp acceleration to max speed
+	InOutAcceleration = InOutAcceleration.GetClampedToMaxSize2D(Input.MaxSpeed);
+	// Find veer
+	const FVector AccelDir = InOutAcceleration.GetSafeNormal2D();
+	const float Veer = Velocity.X * AccelDir.X + Velocity.Y * AccelDir.Y;
+	// Get add speed with air speed cap
+	const float AddSpeed = (Input.bGroundMove ? InOutAcceleration : InOutAcceleration.GetClampedToMaxSize2D(Tuning.AirSpeedCap)).Size2D() - Veer;
+
+	if (AddSpeed <= 0.0f)
+		return Velocity;
+
+	// Apply acceleration
+	const float AccelerationMultiplier = Input.bGroundMove ? Tuning.GroundAccelerationModifier : Tuning.AirAccelerationModifier;
+	const FVector CurrentAcceleration = InOutAcceleration * AccelerationMultiplier * Input.SurfaceFriction * Input.DeltaTime;
+
+	return Velocity + CurrentAcceleration.GetClampedToMaxSize2D(AddSpeed);
+}
+
+void FAlphaVelocityKernel::ApplySpeedLimits(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output)
+{
+	Output.Velocity.X = FMath::Clamp(Output.Velocity.X, -Tuning.AxisSpeedLimit, Tuning.AxisSpeedLimit);
+	Output.Velocity.Y = FMath::Clamp(Output.Velocity.Y, -Tuning.AxisSpeedLimit, Tuning.AxisSpeedLimit);
+
+	const float SpeedSq = Output.Velocity.SizeSquared2D();
+
+	// Dynamic step height code for allowing sliding on a slope when at a high speed
+	if (SpeedSq <= Tuning.MaxWalkSpeedCrouched * Tuning.MaxWalkSpeedCrouched)
+	{
+		// If we're crouching or not sliding, just use max
+		Output.MaxStepHeight = Tuning.DefaultStepHeight;
+		Output.WalkableFloorZ = Tuning.DefaultWalkableFloorZ;
+		return;
+	}
+
+	// Scale step/ramp height down the faster we go
+	const float Speed = FMath::Sqrt(SpeedSq);
+	const float SpeedScale = (Speed - Tuning.MinSlopeSpeedModifier) / (Tuning.MaxSlopeSpeedModifier - Tuning.MinSlopeSpeedModifier);
+	float SpeedMultiplier = FMath::Clamp(SpeedScale, 0.0f, 1.0f);
+	SpeedMultiplier *= SpeedMultiplier;
+
+	// If we're on ground, factor in friction.
+	if (!Input.bFalling)
+		SpeedMultiplier = FMath::Max((1.0f - Input.SurfaceFriction) * SpeedMultiplier, 0.0f);
+
+	Output.MaxStepHeight = FMath::Lerp(Tuning.DefaultStepHeight, Tuning.MinStepHeight, SpeedMultiplier);
+	Output.WalkableFloorZ = FMath::Lerp(Tuning.DefaultWalkableFloorZ, Tuning.SlidingWalkableFloorZ, SpeedMultiplier);
+}
+
+FVector FAlphaVelocityKernel::ApplyBraking(const FAlphaVelocityTuning& Tuning, const FVector& Velocity, float DeltaTime, float Friction, float BrakingDeceleration)
+{
+	if (Velocity.IsNearlyZero(0.1f) || DeltaTime < MIN_TICK_TIME)
+		return Velocity;
+
+	const float Speed = Velocity.Size2D();
+	const float FrictionFactor = FMath::Max(0.0f, Tuning.BrakingFrictionFactor);
+
+	Friction = FMath::Max(0.0f, Friction * FrictionFactor);
+	BrakingDeceleration = FMath::Max(0.0f, FMath::Max(BrakingDeceleration, Speed));
+
+	if (FMath::IsNearlyZero(Friction) || BrakingDeceleration == 0.0f)
+		return Velocity;
+
+	FVector NewVelocity = Velocity;
+	const FVector ReverseAcceleration = -Velocity.GetSafeNormal();
+	const float MaxStepTime = FMath::Clamp(Tuning.BrakingSubStepTime, 1.0f / 75.0f, 1.0f / 20.0f);
+	float RemainingTime = DeltaTime;
+
+	while (RemainingTime >= MIN_TICK_TIME)
+	{
+		const float Delta = (RemainingTime > MaxStepTime ? FMath::Min(MaxStepTime, RemainingTime * 0.5f) : RemainingTime);
+		RemainingTime -= Delta;
+
+		NewVelocity += (Friction * BrakingDeceleration * ReverseAcceleration) * Delta;
+
+		if ((NewVelocity | Velocity) <= 0.0f)
+			return FVector::ZeroVector;
+	}
+
+	if (NewVelocity.IsNearlyZero(KINDA_SMALL_NUMBER))
+		return FVector::ZeroVector;
+
+	return NewVelocity;
+}
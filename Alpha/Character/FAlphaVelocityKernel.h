@@ -0,0 +1,94 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Movement tuning read by the velocity kernel, copied out of UAlphaMovementConfig
+ */
+struct FAlphaVelocityTuning
+{
+	float GroundAccelerationModifier = 0.0f;
+	float AirAccelerationModifier = 0.0f;
+	float AirSpeedCap = 0.0f;
+	float AxisSpeedLimit = 0.0f;
+	float BrakingFriction = 0.0f;
+	float BrakingFrictionFactor = 0.0f;
+	float BrakingSubStepTime = 0.0f;
+	float MaxWalkSpeedCrouched = 0.0f;
+	float MinSlopeSpeedModifier = 0.0f;
+	float MaxSlopeSpeedModifier = 0.0f;
+	float DefaultStepHeight = 0.0f;
+	float MinStepHeight = 0.0f;
+	float DefaultWalkableFloorZ = 0.0f;
+	float SlidingWalkableFloorZ = 0.0f;
+	bool bUseSeparateBrakingFriction = false;
+
+	bool Matches(const FAlphaVelocityTuning& Other) const;
+};
+
+/**
+ * Per character state the velocity kernel runs on, also used as the key for precomputed results
+ */
+struct FAlphaVelocityInput
+{
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+	float DeltaTime = 0.0f;
+	float Friction = 0.0f;
+	float BrakingDeceleration = 0.0f;
+
+	/**
+	 * Max speed after the analog input modifier is applied
+	 */
+	float MaxSpeed = 0.0f;
+	float SurfaceFriction = 1.0f;
+	bool bFluid = false;
+	bool bGroundMove = false;
+	bool bFalling = false;
+
+	bool Matches(const FAlphaVelocityInput& Other) const;
+};
+
+struct FAlphaVelocityOutput
+{
+	FVector Velocity = FVector::ZeroVector;
+
+	/**
+	 * Input acceleration after being clamped to the max speed
+	 */
+	FVector Acceleration = FVector::ZeroVector;
+	float MaxStepHeight = 0.0f;
+	float WalkableFloorZ = 0.0f;
+};
+
+/**
+ * The velocity half of UAlphaMovementConfig::CalcVelocity as pure functions over plain data, so it can run for
+ * every character in parallel before any of them move. Collision is not touched here.
+ */
+class FAlphaVelocityKernel
+{
+public:
+	/**
+	 * Friction, braking, fluid friction and input acceleration followed by the speed dependent floor settings
+	 */
+	static void Calculate(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output);
+
+	/**
+	 * Ground and fluid friction, then clamps to the axis speed limit
+	 */
+	static FVector ApplyFriction(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input);
+
+	/**
+	 * Source style acceleration towards the input, capped by AirSpeedCap in the air
+	 */
+	static FVector ApplyInputAcceleration(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, const FVector& Velocity, FVector& InOutAcceleration);
+
+	/**
+	 * Clamps to the axis speed limit and scales the step height and walkable floor down with speed so fast characters surf slopes
+	 */
+	static void ApplySpeedLimits(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output);
+
+	/**
+	 * Sub stepped braking deceleration against the current velocity
+	 */
+	static FVector ApplyBraking(const FAlphaVelocityTuning& Tuning, const FVector& Velocity, float DeltaTime, float Friction, float BrakingDeceleration);
+};
@@ -0,0 +1,151 @@
+#include "Misc/AutomationTest.h"
+#include "Alpha/Character/AAlphaBaseCharacter.h"
+#include "Alpha/Character/UAlphaMovementConfig.h"
+#include "Components/BoxComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/MemoryBase.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// ticks before counting, the first ones fill caches and reserve the scratch buffers
+const int32 WARMUP_TICKS = 64;
+const int32 COUNTED_TICKS = 256;
+
+/**
+ * Forwards to the real allocator and counts what the game thread asks for, other threads keep running during the test
+ */
+class FAlphaCountingMalloc : public FMalloc
+{
+public:
+	explicit FAlphaCountingMalloc(FMalloc* InInner)
+		: Inner(InInner)
+	{
+	}
+
+	virtual void* Malloc(SIZE_T Size, uint32 Alignment) override
+	{
+		Count();
+		return Inner->Malloc(Size, Alignment);
+	}
+
+	virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override
+	{
+		Count();
+		return Inner->TryMalloc(Size, Alignment);
+	}
+
+	virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override
+	{
+		Count();
+		return Inner->Realloc(Original, Size, Alignment);
+	}
+
+	virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override
+	{
+		Count();
+		return Inner->TryRealloc(Original, Size, Alignment);
+	}
+
+	virtual void Free(void* Original) override
+	{
+		Inner->Free(Original);
+	}
+
+	virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override
+	{
+		return Inner->QuantizeSize(Size, Alignment);
+	}
+
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return Inner->GetAllocationSize(Original, SizeOut);
+	}
+
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		Inner->Trim(bTrimThreadCaches);
+	}
+
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return Inner->IsInternallyThreadSafe();
+	}
+
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return TEXT("AlphaCountingMalloc");
+	}
+
+	int32 NumAllocations = 0;
+
+private:
+	void Count()
+	{
+		if (IsInGameThread())
+			NumAllocations++;
+	}
+
+	FMalloc* Inner;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlphaMovementAllocationTest, "Alpha.Movement.TickAllocations", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAlphaMovementAllocationTest::RunTest(const FString& Parameters)
+{
+	const float DeltaTime = 1.0f / 60.0f;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// a static floor, so the walking steps go through the floor cache like they do in a level
+	AActor* Floor = World->SpawnActor<AActor>();
+	UBoxComponent* FloorBox = NewObject<UBoxComponent>(Floor);
+	FloorBox->SetMobility(EComponentMobility::Static);
+	FloorBox->SetBoxExtent(FVector(10000.0f, 10000.0f, 10.0f));
+	FloorBox->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Floor->SetRootComponent(FloorBox);
+	FloorBox->RegisterComponent();
+
+	AAlphaBaseCharacter* Character = World->SpawnActor<AAlphaBaseCharacter>(FVector(0.0f, 0.0f, 200.0f), FRotator::ZeroRotator);
+	UAlphaMovementConfig* Movement = Character ? Cast<UAlphaMovementConfig>(Character->GetCharacterMovement()) : nullptr;
+
+	if (TestNotNull(TEXT("Movement"), Movement))
+	{
+		// no controller, the character falls onto the floor and runs across it on its own
+		Movement->bRunPhysicsWithNoController = true;
+		Movement->Velocity = FVector(400.0f, 0.0f, 0.0f);
+
+		auto TickCharacter = [Character, Movement, DeltaTime]()
+		{
+			Character->Tick(DeltaTime);
+			Movement->TickComponent(DeltaTime, LEVELTICK_All, &Movement->PrimaryComponentTick);
+		};
+
+		for (int32 Index = 0; Index < WARMUP_TICKS; Index++)
+			TickCharacter();
+
+		// everything allocated before is freed through the proxy too, it forwards every call to the real allocator
+		FMalloc* const RealMalloc = GMalloc;
+		FAlphaCountingMalloc CountingMalloc(RealMalloc);
+		GMalloc = &CountingMalloc;
+
+		for (int32 Index = 0; Index < COUNTED_TICKS; Index++)
+			TickCharacter();
+
+		GMalloc = RealMalloc;
+
+		TestEqual(TEXT("Allocations over the counted ticks"), CountingMalloc.NumAllocations, 0);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "Misc/AutomationTest.h"
+#include "Alpha/Character/FAlphaMovementSnapshot.h"
+#include "Alpha/Character/FAlphaVelocityKernel.h"
+#include "Engine/EngineTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// hashes recorded from a reference build, every build and platform has to reproduce them bit for bit
+const uint32 DEFAULT_SNAPSHOT_HASH = 0x2f1e17c0;
+const uint32 AIR_STRAFE_SNAPSHOT_HASH = 0xcf2ab53d;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlphaMovementSnapshotHashTest, "Alpha.Movement.Deterministic.SnapshotHash", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAlphaMovementSnapshotHashTest::RunTest(const FString& Parameters)
+{
+	const FAlphaMovementSnapshot Snapshot;
+	TestTrue(TEXT("Default snapshot hash"), Snapshot.GetStateHash() == DEFAULT_SNAPSHOT_HASH);
+
+	FAlphaMovementSnapshot Moved = Snapshot;
+	Moved.Tick++;
+	TestTrue(TEXT("Tick is part of the hash"), Moved.GetStateHash() != Snapshot.GetStateHash());
+
+	// the hash packs single precision, differences below it don't count. Away from zero, where a float can still
+	// hold the offset on its own
+	FAlphaMovementSnapshot Far = Snapshot;
+	Far.Location.X = 1000.0;
+
+	FAlphaMovementSnapshot Offset = Far;
+	Offset.Location.X += 1e-12;
+	TestTrue(TEXT("Sub float offset hash"), Offset.GetStateHash() == Far.GetStateHash());
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlphaMovementAirStrafeHashTest, "Alpha.Movement.Deterministic.AirStrafeHash", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAlphaMovementAirStrafeHashTest::RunTest(const FString& Parameters)
+{
+	const float TimeStep = 1.0f / 128.0f;
+
+	FAlphaVelocityTuning Tuning;
+	Tuning.AirAccelerationModifier = 8.0f;
+	Tuning.AirSpeedCap = 32.0f;
+	Tuning.AxisSpeedLimit = 4096.0f;
+	Tuning.MaxWalkSpeedCrouched = 100.0f;
+	Tuning.DefaultStepHeight = 45.0f;
+	Tuning.DefaultWalkableFloorZ = 0.5f;
+
+	// strafes along X then Y, the same steps UAlphaMovementConfig takes in the air minus collision
+	const FVector Inputs[] = { FVector(2048.0f, 0.0f, 0.0f), FVector(2048.0f, 0.0f, 0.0f), FVector(2048.0f, 0.0f, 0.0f), FVector(0.0f, 2048.0f, 0.0f), FVector(0.0f, 2048.0f, 0.0f) };
+
+	FAlphaMovementSnapshot Snapshot;
+	Snapshot.Velocity = FVector(0.0f, 0.0f, -100.0f);
+	Snapshot.MovementMode = MOVE_Falling;
+
+	for (const FVector& Acceleration : Inputs)
+	{
+		FAlphaVelocityInput Input;
+		Input.Velocity = Snapshot.Velocity;
+		Input.Acceleration = Acceleration;
+		Input.DeltaTime = TimeStep;
+		Input.MaxSpeed = 256.0f;
+		Input.bFalling = true;
+
+		FAlphaVelocityOutput Output;
+		FAlphaVelocityKernel::Calculate(Tuning, Input, Output);
+
+		Snapshot.Velocity = FAlphaMovementSnapshot::Quantize(Output.Velocity);
+		Snapshot.Location = FAlphaMovementSnapshot::Quantize(Snapshot.Location + Snapshot.Velocity * TimeStep);
+		Snapshot.MaxStepHeight = Output.MaxStepHeight;
+		Snapshot.WalkableFloorZ = Output.WalkableFloorZ;
+		Snapshot.Tick++;
+	}
+
+	TestEqual(TEXT("Velocity"), Snapshot.Velocity, FVector(32.0f, 32.0f, -100.0f));
+	TestEqual(TEXT("Location"), Snapshot.Location, FVector(1.125f, 0.375f, -3.90625f));
+	TestTrue(TEXT("Air strafe snapshot hash"), Snapshot.GetStateHash() == AIR_STRAFE_SNAPSHOT_HASH);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,110 @@
+#include "UAlphaCharacterPoolSubsystem.h"
+#include "AAlphaBaseCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+
+bool UAlphaCharacterPoolSubsystem::HasAuthority() const
+{
+	// a client spawning its own characters would desync from the replicated ones. checked on use, the net mode
+	// isn't known yet when world subsystems are created
+	return GetWorld()->GetNetMode() != NM_Client;
+}
+
+bool UAlphaCharacterPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+AAlphaBaseCharacter* UAlphaCharacterPoolSubsystem::SpawnCharacter(TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform) const
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	return GetWorld()->SpawnActor<AAlphaBaseCharacter>(CharacterClass, SpawnTransform, SpawnParams);
+}
+
+void UAlphaCharacterPoolSubsystem::Prewarm(TSubclassOf<AAlphaBaseCharacter> CharacterClass, int32 Count)
+{
+	if (CharacterClass == nullptr || Count <= 0 || !HasAuthority())
+		return;
+
+	// room for every prewarmed character to be released at once without growing
+	TArray<AAlphaBaseCharacter*>& Pool = Pools.FindOrAdd(CharacterClass).Characters;
+	Pool.Reserve(Pool.Num() + Count);
+
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		AAlphaBaseCharacter* Character = SpawnCharacter(CharacterClass, FTransform::Identity);
+
+		if (Character == nullptr)
+		{
+			UE_LOG(LogTemp, Error, TEXT("UAlphaCharacterPoolSubsystem failed to spawn %s"), *CharacterClass->GetName());
+			return;
+		}
+
+		Character->DeactivateForPool();
+		Pool.Add(Character);
+	}
+}
+
+AAlphaBaseCharacter* UAlphaCharacterPoolSubsystem::Acquire(TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform)
+{
+	if (CharacterClass == nullptr || !HasAuthority())
+		return nullptr;
+
+	if (FAlphaCharacterPoolList* List = Pools.Find(CharacterClass))
+	{
+		// characters destroyed while pooled (level streaming, kill volumes) are skipped
+		while (List->Characters.Num() > 0)
+		{
+			AAlphaBaseCharacter* Character = List->Characters.Pop(EAllowShrinking::No);
+
+			if (!IsValid(Character))
+				continue;
+
+			Character->ResetForRespawn(SpawnTransform);
+			return Character;
+		}
+	}
+
+	return SpawnCharacter(CharacterClass, SpawnTransform);
+}
+
+void UAlphaCharacterPoolSubsystem::Release(AAlphaBaseCharacter* Character)
+{
+	if (!IsValid(Character) || Character->IsPooled() || !HasAuthority())
+		return;
+
+	if (AController* Controller = Character->GetController())
+		Controller->UnPossess();
+
+	Character->DeactivateForPool();
+	Pools.FindOrAdd(Character->GetClass()).Characters.Add(Character);
+}
+
+AAlphaBaseCharacter* UAlphaCharacterPoolSubsystem::Respawn(AController* Controller, TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform)
+{
+	if (Controller == nullptr || !HasAuthority())
+		return nullptr;
+
+	if (AAlphaBaseCharacter* Current = Cast<AAlphaBaseCharacter>(Controller->GetPawn()))
+		Release(Current);
+
+	AAlphaBaseCharacter* Character = Acquire(CharacterClass, SpawnTransform);
+
+	if (Character == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UAlphaCharacterPoolSubsystem failed to respawn %s"), *GetNameSafe(Controller));
+		return nullptr;
+	}
+
+	Controller->Possess(Character);
+	Controller->ClientSetRotation(SpawnTransform.Rotator());
+	return Character;
+}
+
+int32 UAlphaCharacterPoolSubsystem::GetNumPooled(TSubclassOf<AAlphaBaseCharacter> CharacterClass) const
+{
+	const FAlphaCharacterPoolList* List = Pools.Find(CharacterClass);
+	return List ? List->Characters.Num() : 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "UAlphaCharacterPoolSubsystem.generated.h"
+
+class AAlphaBaseCharacter;
+class AController;
+
+USTRUCT()
+struct FAlphaCharacterPoolList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AAlphaBaseCharacter*> Characters;
+};
+
+/**
+ * Keeps dead characters around to respawn them in place instead of destroying and spawning new ones.
+ *
+ * A released character is unpossessed, hidden and stops ticking, acquiring it again resets its movement and
+ * state and moves it to the spawn transform, so a respawn runs no constructors and the pool arrays only grow
+ * while prewarming or when more characters are alive at once than ever before. Does nothing in worlds
+ * without authority, clients receive the pooled characters like any other.
+ */
+UCLASS()
+class UAlphaCharacterPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Spawns characters into the pool ahead of time
+	 */
+	void Prewarm(TSubclassOf<AAlphaBaseCharacter> CharacterClass, int32 Count);
+
+	/**
+	 * Returns a pooled character of the class reset at a transform, spawns one if the pool is empty
+	 */
+	AAlphaBaseCharacter* Acquire(TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform);
+
+	/**
+	 * Unpossesses a character and returns it to the pool
+	 */
+	void Release(AAlphaBaseCharacter* Character);
+
+	/**
+	 * Releases the controller's current character and possesses a pooled one at a transform
+	 */
+	AAlphaBaseCharacter* Respawn(AController* Controller, TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform);
+
+	int32 GetNumPooled(TSubclassOf<AAlphaBaseCharacter> CharacterClass) const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	AAlphaBaseCharacter* SpawnCharacter(TSubclassOf<AAlphaBaseCharacter> CharacterClass, const FTransform& SpawnTransform) const;
+	bool HasAuthority() const;
+
+	UPROPERTY()
+	TMap<TSubclassOf<AAlphaBaseCharacter>, FAlphaCharacterPoolList> Pools;
+};
@@ -20,6 +20,9 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	class UInputAction* InputJump;
 
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	class UInputAction* InputCrouch;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	class UInputAction* InputSpecial1;
 
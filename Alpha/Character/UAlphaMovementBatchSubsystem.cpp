@@ -0,0 +1,129 @@
+#include "UAlphaMovementBatchSubsystem.h"
+#include "Alpha/Alpha.h"
+#include "UAlphaMovementConfig.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Velocity Phase"), STAT_AlphaVelocityPhase, STATGROUP_AlphaMovement);
+
+static TAutoConsoleVariable<int32> CVarParallelVelocity(
+	TEXT("alpha.Movement.ParallelVelocity"),
+	1,
+	TEXT("Computes every character's velocity in parallel before the movement ticks. 0: off, 1: on"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<int32> CVarParallelVelocityBatchSize(
+	TEXT("alpha.Movement.ParallelVelocityBatchSize"),
+	32,
+	TEXT("Characters per worker batch in the velocity phase"),
+	ECVF_Default
+);
+
+void FAlphaMovementBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Subsystem && TickType != LEVELTICK_ViewportsOnly)
+		Subsystem->RunVelocityPhase(DeltaTime);
+}
+
+FString FAlphaMovementBatchTickFunction::DiagnosticMessage()
+{
+	return TEXT("FAlphaMovementBatchTickFunction");
+}
+
+void UAlphaMovementBatchSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// set up before any component registers, AddPrerequisite drops targets which can't tick. level placed
+	// characters register while the level initializes, before begin play
+	BatchTick.Subsystem = this;
+	BatchTick.bCanEverTick = true;
+	BatchTick.bStartWithTickEnabled = true;
+	BatchTick.TickGroup = TG_PrePhysics;
+}
+
+void UAlphaMovementBatchSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+	BatchTick.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UAlphaMovementBatchSubsystem::Deinitialize()
+{
+	if (BatchTick.IsTickFunctionRegistered())
+		BatchTick.UnRegisterTickFunction();
+
+	Components.Reset();
+	Items.Reset();
+
+	Super::Deinitialize();
+}
+
+void UAlphaMovementBatchSubsystem::Register(UAlphaMovementConfig* Component)
+{
+	Components.AddUnique(Component);
+	Component->PrimaryComponentTick.AddPrerequisite(this, BatchTick);
+}
+
+void UAlphaMovementBatchSubsystem::Unregister(UAlphaMovementConfig* Component)
+{
+	Components.RemoveSingleSwap(Component);
+	Component->PrimaryComponentTick.RemovePrerequisite(this, BatchTick);
+}
+
+void UAlphaMovementBatchSubsystem::AddInputPrerequisite(UObject* Object, FTickFunction& TickFunction)
+{
+	BatchTick.AddPrerequisite(Object, TickFunction);
+}
+
+void UAlphaMovementBatchSubsystem::RemoveInputPrerequisite(UObject* Object, FTickFunction& TickFunction)
+{
+	BatchTick.RemovePrerequisite(Object, TickFunction);
+}
+
+bool UAlphaMovementBatchSubsystem::IsVelocityPhaseEnabled() const
+{
+	return CVarParallelVelocity.GetValueOnGameThread() != 0 && BatchTick.IsTickFunctionRegistered();
+}
+
+void UAlphaMovementBatchSubsystem::RunVelocityPhase(float DeltaTime)
+{
+	if (!IsVelocityPhaseEnabled() || Components.Num() == 0)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_AlphaVelocityPhase);
+
+	// gather on the game thread, components may not be touched from the workers
+	Items.Reset();
+
+	for (UAlphaMovementConfig* Component : Components)
+	{
+		FBatchItem Item;
+
+		if (!Component->GatherVelocityInput(DeltaTime, Item.Input))
+			continue;
+
+		Item.Component = Component;
+		Item.Tuning = Component->GetVelocityTuning();
+		Items.Add(Item);
+	}
+
+	const int32 BatchSize = FMath::Max(CVarParallelVelocityBatchSize.GetValueOnGameThread(), 1);
+	const int32 NumBatches = FMath::DivideAndRoundUp(Items.Num(), BatchSize);
+
+	ParallelFor(NumBatches, [this, BatchSize](int32 Batch)
+	{
+		const int32 Last = FMath::Min((Batch + 1) * BatchSize, Items.Num());
+
+		for (int32 Index = Batch * BatchSize; Index < Last; Index++)
+		{
+			FBatchItem& Item = Items[Index];
+			FAlphaVelocityKernel::Calculate(Item.Tuning, Item.Input, Item.Output);
+		}
+	});
+
+	for (const FBatchItem& Item : Items)
+		Item.Component->SetPrecomputedVelocity(Item.Tuning, Item.Input, Item.Output);
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "FAlphaVelocityKernel.h"
+#include "UAlphaMovementBatchSubsystem.generated.h"
+
+class UAlphaMovementBatchSubsystem;
+class UAlphaMovementConfig;
+
+USTRUCT()
+struct FAlphaMovementBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UAlphaMovementBatchSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FAlphaMovementBatchTickFunction> : public TStructOpsTypeTraitsBase2<FAlphaMovementBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Splits movement into two phases for every registered UAlphaMovementConfig.
+ *
+ * The velocity phase runs once per frame before any character moves and computes every character's new velocity
+ * with FAlphaVelocityKernel across worker threads. The collision phase is each character's own movement tick,
+ * which consumes the precomputed velocity and only does the sweeps. A character whose state changed in between
+ * (jumping, landing, a mode change) simply recomputes inline.
+ *
+ * On a server, moves received from remote players are held until their character's movement tick, so the first
+ * one joins the velocity phase like any other update.
+ */
+UCLASS()
+class UAlphaMovementBatchSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Adds a component to the velocity phase, its movement tick will wait for the phase to finish
+	 */
+	void Register(UAlphaMovementConfig* Component);
+	void Unregister(UAlphaMovementConfig* Component);
+
+	/**
+	 * Makes the velocity phase wait for a tick function which feeds input, such as the owning controller
+	 */
+	void AddInputPrerequisite(UObject* Object, FTickFunction& TickFunction);
+	void RemoveInputPrerequisite(UObject* Object, FTickFunction& TickFunction);
+
+	void RunVelocityPhase(float DeltaTime);
+
+	/**
+	 * False while alpha.Movement.ParallelVelocity is off
+	 */
+	bool IsVelocityPhaseEnabled() const;
+
+private:
+	struct FBatchItem
+	{
+		UAlphaMovementConfig* Component;
+		FAlphaVelocityTuning Tuning;
+		FAlphaVelocityInput Input;
+		FAlphaVelocityOutput Output;
+	};
+
+	UPROPERTY(Transient)
+	TArray<UAlphaMovementConfig*> Components;
+
+	FAlphaMovementBatchTickFunction BatchTick;
+	TArray<FBatchItem> Items;
+};
@@ -0,0 +1,100 @@
+#include "UAlphaMovementBudgetSubsystem.h"
+#include "UAlphaMovementConfig.h"
+#include "FAlphaMovementCounters.h"
+#include "GameFramework/Character.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarMovementBudget(
+	TEXT("alpha.Movement.BudgetMs"),
+	4.0f,
+	TEXT("Movement time (in ms) per frame before non-player characters are degraded. 0 disables the budget"),
+	ECVF_Default);
+
+// weight of the newest frame in the projected cost
+const float COST_SMOOTHING = 0.2f;
+// fraction of the budget the projection has to stay under before a tier is restored
+const float TIER_RECOVER_FRACTION = 0.6f;
+// seconds between degrading steps, so every step gets measured before the next one
+const float TIER_DEGRADE_DELAY = 0.25f;
+// seconds under budget before restoring a tier
+const float TIER_RECOVER_DELAY = 2.0f;
+
+bool UAlphaMovementBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlphaMovementBudgetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlphaMovementBudgetSubsystem, STATGROUP_Tickables);
+}
+
+void UAlphaMovementBudgetSubsystem::Tick(float DeltaTime)
+{
+	const uint64 MovementCycles = FAlphaMovementCounters::GetTotal().MovementCycles;
+	const float FrameCost = bHasLastMovementCycles ? static_cast<float>(FPlatformTime::ToMilliseconds64(MovementCycles - LastMovementCycles)) : 0.0f;
+
+	LastMovementCycles = MovementCycles;
+	bHasLastMovementCycles = true;
+
+	const float BudgetMs = CVarMovementBudget.GetValueOnGameThread();
+
+	if (BudgetMs <= 0.0f)
+	{
+		if (Tier != EAlphaMovementTier::Full)
+			SetTier(EAlphaMovementTier::Full, BudgetMs);
+
+		return;
+	}
+
+	ProjectedCost = FMath::Lerp(ProjectedCost, FrameCost, COST_SMOOTHING);
+	TimeInTier += DeltaTime;
+
+	if (ProjectedCost > BudgetMs)
+	{
+		if (Tier != EAlphaMovementTier::ReducedProxyRate && TimeInTier >= TIER_DEGRADE_DELAY)
+			SetTier(static_cast<EAlphaMovementTier>(static_cast<uint8>(Tier) + 1), BudgetMs);
+	}
+	else if (ProjectedCost < BudgetMs * TIER_RECOVER_FRACTION)
+	{
+		if (Tier != EAlphaMovementTier::Full && TimeInTier >= TIER_RECOVER_DELAY)
+			SetTier(static_cast<EAlphaMovementTier>(static_cast<uint8>(Tier) - 1), BudgetMs);
+	}
+	else
+	{
+		// in between, hold the tier and restart the recovery wait
+		TimeInTier = FMath::Min(TimeInTier, TIER_DEGRADE_DELAY);
+	}
+}
+
+void UAlphaMovementBudgetSubsystem::SetTier(EAlphaMovementTier NewTier, float BudgetMs)
+{
+	UE_LOG(LogTemp, Display, TEXT("UAlphaMovementBudgetSubsystem tier %d -> %d, projected %.2f ms for a %.2f ms budget"), static_cast<int32>(Tier), static_cast<int32>(NewTier), ProjectedCost, BudgetMs);
+
+	Tier = NewTier;
+	TimeInTier = 0.0f;
+}
+
+EAlphaMovementTier UAlphaMovementBudgetSubsystem::GetMovementTier(const UAlphaMovementConfig* Component) const
+{
+	if (Tier == EAlphaMovementTier::Full || Component == nullptr)
+		return EAlphaMovementTier::Full;
+
+	// clients only simulate their own character, and players' moves stay exact
+	const ACharacter* Character = Component->GetCharacterOwner();
+
+	if (Character == nullptr || Character->GetLocalRole() != ROLE_Authority || Character->IsPlayerControlled())
+		return EAlphaMovementTier::Full;
+
+	return Tier;
+}
+
+bool UAlphaMovementBudgetSubsystem::IsProxyRateReduced(const UAlphaMovementConfig* Component) const
+{
+	if (Tier < EAlphaMovementTier::ReducedProxyRate || Component == nullptr)
+		return false;
+
+	// only the server replicates, a player's own moves are unaffected by how often others hear about them
+	const ACharacter* Character = Component->GetCharacterOwner();
+	return Character && Character->GetLocalRole() == ROLE_Authority;
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "UAlphaMovementBudgetSubsystem.generated.h"
+
+class UAlphaMovementConfig;
+
+/**
+ * Movement fidelity, every tier keeps the savings of the tiers before it
+ */
+UENUM(BlueprintType)
+enum class EAlphaMovementTier : uint8
+{
+	/** Full simulation */
+	Full,
+
+	/** Surface friction is only traced again when the floor component changes */
+	CachedFriction,
+
+	/** One collision bump per falling step and no floor checks while standing still */
+	ReducedIterations,
+
+	/** Replicated at the idle net update rate, the only tier players get */
+	ReducedProxyRate
+};
+
+/**
+ * Keeps the game thread's movement cost within a per-frame budget.
+ *
+ * The cost of every movement update is summed from FAlphaMovementCounters each frame and smoothed into a projection
+ * of the next frame. While the projection is over budget the tier steps down one level at a time, and it steps back
+ * up once the cost has stayed well under budget for a while. Only characters simulated on the server without a
+ * player have their simulation degraded, player controlled moves always run at full fidelity. Players still
+ * replicate to others at the reduced proxy rate, that only changes what other clients see of them.
+ */
+UCLASS()
+class UAlphaMovementBudgetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Tier a component should run its next update at
+	 */
+	EAlphaMovementTier GetMovementTier(const UAlphaMovementConfig* Component) const;
+
+	/**
+	 * Whether a component's character should replicate at the idle net update rate, players included
+	 */
+	bool IsProxyRateReduced(const UAlphaMovementConfig* Component) const;
+
+	/**
+	 * Tier applied to characters which can be degraded
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement Budget")
+	EAlphaMovementTier GetCurrentTier() const
+	{
+		return Tier;
+	}
+
+	/**
+	 * Projected movement cost (in ms) of the next frame
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Movement Budget")
+	float GetProjectedCost() const
+	{
+		return ProjectedCost;
+	}
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void SetTier(EAlphaMovementTier NewTier, float BudgetMs);
+
+	EAlphaMovementTier Tier = EAlphaMovementTier::Full;
+	float ProjectedCost = 0.0f;
+	float TimeInTier = 0.0f;
+	uint64 LastMovementCycles = 0;
+	bool bHasLastMovementCycles = false;
+};
@@ -1,18 +1,58 @@
 #include "UAlphaMovementConfig.h"
 #include "AAlphaBaseCharacter.h"
+#include "FAlphaMovementCounters.h"
+#include "UAlphaMovementBatchSubsystem.h"
+#include "Alpha/World/UAlphaMovementZoneSubsystem.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "Engine/World.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "PhysicsEngine/PhysicsSettings.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
 #include "Math/UnitConversion.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/IConsoleManager.h"
 
 // magic numbers
 constexpr float DesiredGravity = -1143.0f;
 constexpr float JumpVelocity = 266.7f;
 const float MAX_STEP_SIDE_Z = 0.08f;
 const float VERTICAL_SLOPE_NORMAL_Z = 0.001f;
+const float SLIDING_WALKABLE_FLOOR_Z = 0.9848f;
+const int32 MAX_CLIP_PLANES = 5;
+const int32 MAX_CLIP_BUMPS = 4;
+// velocity (unit/s) into a plane below which the plane is ignored
+const float CLIP_PLANE_TOLERANCE = 0.1f;
+// clip bumps per falling step at reduced movement tiers
+const int32 REDUCED_CLIP_BUMPS = 1;
+// sweeps kept per captured tick, a runaway tick only needs its first ones to be reproduced
+const int32 MAX_CAPTURED_SWEEPS = 64;
+// client moves held for the movement tick, a client flooding moves has the older ones simulated right away
+const int32 MAX_DEFERRED_SERVER_MOVES = 16;
+
+static TAutoConsoleVariable<float> CVarSlowTickMs(
+	TEXT("alpha.Movement.SlowTickMs"),
+	0.0f,
+	TEXT("Movement tick time (in ms) above which a character's tick is written to Saved/MovementCaptures for replay. 0 disables the watchdog"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarSlowTickMaxCaptures(
+	TEXT("alpha.Movement.SlowTickMaxCaptures"),
+	16,
+	TEXT("Max slow ticks written per session"),
+	ECVF_Default);
+
+static int32 NumSlowTickCaptures = 0;
+
+static TAutoConsoleVariable<int32> CVarReplayFloorCache(
+	TEXT("alpha.Movement.ReplayFloorCache"),
+	1,
+	TEXT("Reuses floor queries an autonomous proxy already made when it replays saved moves after a correction. 0 disables the floor cache"),
+	ECVF_Default
+);
 
 /**
  * Calculates the friction from hitting a physical object
@@ -42,6 +82,33 @@ UAlphaMovementConfig::UAlphaMovementConfig()
 	GroundFriction = 4.0f;
 	BrakingFriction = 4.0f;
 	SurfaceFriction = 1.0f;
+	DemoTime = 0.0f;
+	MovementEvents = nullptr;
+	MovementBatch = nullptr;
+	MoveValidation = nullptr;
+	MovementZones = nullptr;
+	MovementBudget = nullptr;
+	MovementTier = EAlphaMovementTier::Full;
+	bProxyRateReduced = false;
+	bDefaultAlwaysCheckFloor = bAlwaysCheckFloor;
+	ClaimedLocation = FVector::ZeroVector;
+	bHasClaimedLocation = false;
+	bForceMoveCorrection = false;
+	bHasPrecomputedVelocity = false;
+	bFloorQueryParamsValid = false;
+	bCapturingTick = false;
+	bReplayingCapture = false;
+	DefaultMoveDataContainer = &GetNetworkMoveDataContainer();
+	AsyncSequence = 0;
+	bAsyncPhysicsMovementActive.store(false, std::memory_order_relaxed);
+	AsyncVelocity = FVector::ZeroVector;
+	bHasAsyncInput = false;
+	DeterministicTick = 0;
+	DeterministicTimeAccumulator = 0.0f;
+	PendingStepAcceleration = FVector::ZeroVector;
+	DeterministicMoveTimeStamp = 0.0f;
+	bHasDeterministicMoveTimeStamp = false;
+	bResimulating = false;
 	bUseSeparateBrakingFriction = false;
 	BrakingFrictionFactor = 1.0f;
 	BrakingSubStepTime = 0.015f;
@@ -52,6 +119,11 @@ UAlphaMovementConfig::UAlphaMovementConfig()
 	BrakingDecelerationFlying = 190.5f;
 	BrakingDecelerationSwimming = 190.5f;
 	BrakingDecelerationWalking = 190.5f;
+	MaxWalkSpeedCrouched = BaseMovementSpeed * 0.34f;
+	SetCrouchedHalfHeight(48.0f);
+	UncrouchClearanceLocation = FVector::ZeroVector;
+	UncrouchCeilingZ = 0.0f;
+	bHasUncrouchClearance = false;
 	MaxStepHeight = 34.29f;
 	DefaultStepHeight = MaxStepHeight;
 	MinStepHeight = 10.0f;
@@ -82,23 +154,147 @@ UAlphaMovementConfig::UAlphaMovementConfig()
 	NavAgentProps.bCanFly = true;
 	GravityScale = DesiredGravity / UPhysicsSettings::Get()->DefaultGravityZ;
 	bMaintainHorizontalGroundVelocity = true;
+
+	// the Hermite smoother stamps proxy states with it, by default it is only sent with linear smoothing
+	bNetworkAlwaysReplicateTransformUpdateTimestamp = true;
+	LastProxyServerTime = 0.0f;
+	LastProxyLocalTime = 0.0f;
+	bWarnedStaleProxyTime = false;
 }
 
 void UAlphaMovementConfig::InitializeComponent()
 {
 	Super::InitializeComponent();
 	AlphaCharacter = Cast<AAlphaBaseCharacter>(GetOwner());
+	MovementEvents = GetWorld() ? GetWorld()->GetSubsystem<UAlphaMovementEventSubsystem>() : nullptr;
+	MovementBatch = GetWorld() ? GetWorld()->GetSubsystem<UAlphaMovementBatchSubsystem>() : nullptr;
+	MoveValidation = GetWorld() ? GetWorld()->GetSubsystem<UAlphaMoveValidationSubsystem>() : nullptr;
+	MovementZones = GetWorld() ? GetWorld()->GetSubsystem<UAlphaMovementZoneSubsystem>() : nullptr;
+	MovementBudget = GetWorld() ? GetWorld()->GetSubsystem<UAlphaMovementBudgetSubsystem>() : nullptr;
+	bDefaultAlwaysCheckFloor = bAlwaysCheckFloor;
+
+	if (MovementBatch)
+		MovementBatch->Register(this);
+
+	// deterministic steps have to own the whole update
+	if (bUseAsyncPhysicsMovement && !bDeterministicMovement)
+	{
+		if (UPhysicsSettings::Get()->bTickPhysicsAsync)
+		{
+			bAsyncPhysicsMovementActive.store(true, std::memory_order_relaxed);
+			SetAsyncPhysicsTickEnabled(true);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UAlphaMovementConfig async physics movement needs Tick Physics Async in the physics settings, %s moves on the game thread"), *GetNameSafe(GetOwner()));
+		}
+	}
 }
 
 void UAlphaMovementConfig::OnRegister()
 {
 	Super::OnRegister();
+	bFloorQueryParamsValid = false;
+}
+
+void UAlphaMovementConfig::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopDemoRecording();
+
+	if (MovementBatch)
+	{
+		MovementBatch->Unregister(this);
+
+		if (AController* OldController = BatchInputController.Get())
+			MovementBatch->RemoveInputPrerequisite(OldController, OldController->PrimaryActorTick);
+
+		BatchInputController = nullptr;
+	}
+
+	FlushDeferredServerMoves();
+
+	if (IsAsyncPhysicsMovementActive())
+	{
+		bAsyncPhysicsMovementActive.store(false, std::memory_order_relaxed);
+		SetAsyncPhysicsTickEnabled(false);
+		AsyncMovement.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UAlphaMovementConfig::StartDemoRecording(const FString& Filename)
+{
+	StopDemoRecording();
+
+	DemoWriter = MakeUnique<FAlphaDemoWriter>();
+	DemoTime = 0.0f;
+
+	if (!DemoWriter->Open(Filename, AxisSpeedLimit))
+	{
+		DemoWriter.Reset();
+		return false;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UAlphaMovementConfig recording demo to %s"), *Filename);
+	return true;
+}
+
+void UAlphaMovementConfig::StopDemoRecording()
+{
+	if (!DemoWriter.IsValid())
+		return;
+
+	UE_LOG(LogTemp, Display, TEXT("UAlphaMovementConfig recorded %d demo frames"), DemoWriter->GetNumFrames());
+
+	DemoWriter->Close();
+	DemoWriter.Reset();
 }
 
 void UAlphaMovementConfig::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	// counted as server moves, not as part of the tick
+	FlushDeferredServerMoves();
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	// a replayed tick records the same floor and sweeps, so it can be compared with what was captured
+	if (bReplayingCapture || ShouldCaptureSlowTicks())
+		BeginTickCapture(DeltaTime);
+
+	ON_SCOPE_EXIT
+	{
+		const uint64 TickCycles = FPlatformTime::Cycles64() - StartCycles;
+
+		FAlphaMovementCounters& Counters = FAlphaMovementCounters::Get();
+		Counters.MovementCycles += TickCycles;
+
+		// a remote player's updates are its server moves, which count themselves
+		if (!IsMovedByServerMoves())
+		{
+			Counters.MovementUpdates++;
+			Counters.AddSpeedSample(Velocity.Size());
+		}
+
+		FinishTickCapture(TickCycles);
+		bReplayingCapture = false;
+	};
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	// input for the next velocity phase comes from the controller tick
+	if (MovementBatch && CharacterOwner && CharacterOwner->Controller != BatchInputController.Get())
+	{
+		// the batch tick would keep waiting on a controller which no longer possesses us
+		if (AController* OldController = BatchInputController.Get())
+			MovementBatch->RemoveInputPrerequisite(OldController, OldController->PrimaryActorTick);
+
+		BatchInputController = CharacterOwner->Controller;
+
+		if (CharacterOwner->Controller)
+			MovementBatch->AddInputPrerequisite(CharacterOwner->Controller, CharacterOwner->Controller->PrimaryActorTick);
+	}
+
 	if (UpdatedComponent->IsSimulatingPhysics())
 		return;
 
@@ -111,6 +307,448 @@ void UAlphaMovementConfig::TickComponent(float DeltaTime, ELevelTick TickType, F
 	}
 
 	bBrakingFrameTolerated = IsMovingOnGround();
+
+	if (IsAsyncPhysicsMovementActive())
+	{
+		if (CharacterOwner->IsLocallyControlled())
+		{
+			PushAsyncMovementState();
+		}
+		else if (AsyncSequence != 0)
+		{
+			// lost control, the physics tick would keep stepping the last input
+			AsyncMovement.Reset();
+			AsyncSequence = 0;
+		}
+	}
+
+	if (DemoWriter.IsValid())
+	{
+		DemoTime += DeltaTime;
+
+		FAlphaDemoFrame Frame;
+		Frame.Time = DemoTime;
+		Frame.Location = UpdatedComponent->GetComponentLocation();
+		Frame.Velocity = Velocity;
+		Frame.ControlRotation = AlphaCharacter->GetControlRotation();
+		Frame.MovementMode = MovementMode;
+		DemoWriter->AddFrame(Frame);
+	}
+}
+
+void UAlphaMovementConfig::BeginTickCapture(float DeltaTime)
+{
+	if (!HasValidData())
+		return;
+
+	bCapturingTick = true;
+
+	// the sweep list keeps its allocation between captured ticks
+	TickCapture.Sweeps.Reserve(MAX_CAPTURED_SWEEPS);
+	TickCapture.Sweeps.Reset();
+
+	TickCapture.DeltaTime = DeltaTime;
+	TickCapture.Before = CaptureSnapshot();
+	TickCapture.InputVector = GetPendingInputVector();
+	TickCapture.ControlRotation = CharacterOwner->GetControlRotation();
+	TickCapture.bPressedJump = CharacterOwner->bPressedJump;
+	TickCapture.bWantsToCrouch = bWantsToCrouch;
+	TickCapture.bIsCrouched = CharacterOwner->bIsCrouched;
+	TickCapture.Tuning = GetVelocityTuning();
+	TickCapture.GravityZ = GetGravityZ();
+	TickCapture.MaxSpeed = GetMaxSpeed();
+	TickCapture.FloorNormal = CurrentFloor.HitResult.ImpactNormal;
+	TickCapture.FloorDist = CurrentFloor.FloorDist;
+	TickCapture.bWalkableFloor = CurrentFloor.IsWalkableFloor();
+}
+
+bool UAlphaMovementConfig::ShouldCaptureSlowTicks() const
+{
+	return CVarSlowTickMs.GetValueOnGameThread() > 0.0f && NumSlowTickCaptures < CVarSlowTickMaxCaptures.GetValueOnGameThread();
+}
+
+void UAlphaMovementConfig::FinishTickCapture(uint64 TickCycles)
+{
+	if (!bCapturingTick)
+		return;
+
+	const float TickMs = static_cast<float>(FPlatformTime::ToMilliseconds64(TickCycles));
+
+	if (!bReplayingCapture && TickMs > CVarSlowTickMs.GetValueOnGameThread())
+		EndTickCapture(TickMs);
+
+	bCapturingTick = false;
+}
+
+void UAlphaMovementConfig::EndTickCapture(float TickMs)
+{
+	NumSlowTickCaptures++;
+
+	TickCapture.TickMs = TickMs;
+	TickCapture.After = CaptureSnapshot();
+	TickCapture.MapName = GetWorld()->GetMapName();
+	TickCapture.CharacterClass = CharacterOwner->GetClass()->GetPathName();
+
+	const FString Filename = FPaths::ProjectSavedDir() / TEXT("MovementCaptures") / FString::Printf(TEXT("%s_%llu.alphacapture"), *GetNameSafe(CharacterOwner), GFrameCounter);
+
+	if (TickCapture.Save(Filename))
+		UE_LOG(LogTemp, Warning, TEXT("UAlphaMovementConfig %s took %.2fms to tick, captured to %s"), *GetNameSafe(CharacterOwner), TickMs, *Filename);
+}
+
+void UAlphaMovementConfig::ApplyCapture(const FAlphaMovementCapture& Capture)
+{
+	if (!HasValidData())
+		return;
+
+	RestoreSnapshot(Capture.Before);
+
+	// crouching resizes the capsule, it has to match before the state is restored on top of it
+	if (Capture.bIsCrouched != CharacterOwner->bIsCrouched)
+	{
+		if (Capture.bIsCrouched)
+			Crouch();
+		else
+			UnCrouch();
+
+		RestoreSnapshot(Capture.Before);
+	}
+
+	ConsumeInputVector();
+	AddInputVector(Capture.InputVector, true);
+	bWantsToCrouch = Capture.bWantsToCrouch;
+	CharacterOwner->bPressedJump = Capture.bPressedJump;
+
+	if (AController* Controller = CharacterOwner->GetController())
+		Controller->SetControlRotation(Capture.ControlRotation);
+
+	bReplayingCapture = true;
+}
+
+void UAlphaMovementConfig::PerformMovement(float DeltaTime)
+{
+	if (!bDeterministicMovement || bResimulating || !HasValidData())
+	{
+		Super::PerformMovement(DeltaTime);
+		return;
+	}
+
+	const float TimeStep = FMath::Max(DeterministicTimeStep, MIN_TICK_TIME);
+	const int32 Steps = GetDeterministicSteps(DeltaTime, TimeStep);
+
+	if (Steps == 0)
+	{
+		// nothing moved, the move that steps next uses this frame's input if it gets none of its own. kept aside
+		// rather than added back to the input vector, which would sum the input of every frame that didn't step
+		if (CharacterOwner->IsLocallyControlled() && !bHasDeterministicMoveTimeStamp && !Acceleration.IsZero())
+			PendingStepAcceleration = Acceleration;
+
+		return;
+	}
+
+	if (!PendingStepAcceleration.IsZero())
+	{
+		if (Acceleration.IsZero())
+		{
+			Acceleration = PendingStepAcceleration;
+			AnalogInputModifier = ComputeAnalogInputModifier();
+		}
+
+		PendingStepAcceleration = FVector::ZeroVector;
+	}
+
+	for (int32 Step = 0; Step < Steps; Step++)
+	{
+		BeginDeterministicStep();
+		Super::PerformMovement(TimeStep);
+		EndDeterministicStep();
+	}
+}
+
+int32 UAlphaMovementConfig::GetDeterministicSteps(float DeltaTime, float TimeStep)
+{
+	float MoveTimeStamp = 0.0f;
+
+	// client moves step on their own timestamps, so the client, the server and a replay after a correction agree on
+	// the step boundaries without sharing an accumulator
+	if (GetDeterministicMoveTimeStamp(MoveTimeStamp))
+	{
+		const int32 FirstStep = FMath::FloorToInt((MoveTimeStamp - DeltaTime) / TimeStep) + 1;
+		const int32 EndStep = FMath::FloorToInt(MoveTimeStamp / TimeStep) + 1;
+
+		DeterministicTick = static_cast<uint32>(FirstStep);
+		return FMath::Clamp(EndStep - FirstStep, 0, MaxDeterministicSteps);
+	}
+
+	int32 Steps = 0;
+	DeterministicTimeAccumulator += DeltaTime;
+
+	while (DeterministicTimeAccumulator >= TimeStep && Steps < MaxDeterministicSteps)
+	{
+		DeterministicTimeAccumulator -= TimeStep;
+		Steps++;
+	}
+
+	if (Steps == MaxDeterministicSteps)
+		DeterministicTimeAccumulator = FMath::Min(DeterministicTimeAccumulator, TimeStep);
+
+	return Steps;
+}
+
+bool UAlphaMovementConfig::GetDeterministicMoveTimeStamp(float& OutTimeStamp) const
+{
+	// set by MoveAutonomous, a client move on the server or a saved move replayed on the client
+	if (bHasDeterministicMoveTimeStamp)
+	{
+		OutTimeStamp = DeterministicMoveTimeStamp;
+		return true;
+	}
+
+	// a new move on the client, ReplicateMoveToServer has already advanced the timestamp it is saved with
+	if (CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy && IsNetMode(NM_Client))
+	{
+		if (const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character())
+		{
+			OutTimeStamp = ClientData->CurrentTimeStamp;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void UAlphaMovementConfig::BeginDeterministicStep()
+{
+	// perch nudges in PhysFalling are the only random movement
+	RandomStream.Initialize(static_cast<int32>(HashCombine(DeterministicTick, static_cast<uint32>(DeterministicSeed))));
+}
+
+void UAlphaMovementConfig::EndDeterministicStep()
+{
+	// snapping to a grid keeps float error from one step from leaking into the next
+	Velocity = FAlphaMovementSnapshot::Quantize(Velocity);
+
+	if (UpdatedComponent)
+		UpdatedComponent->SetWorldLocation(FAlphaMovementSnapshot::Quantize(UpdatedComponent->GetComponentLocation()), false, nullptr, ETeleportType::None);
+
+	DeterministicTick++;
+}
+
+FAlphaMovementSnapshot UAlphaMovementConfig::CaptureSnapshot() const
+{
+	FAlphaMovementSnapshot Snapshot;
+
+	if (UpdatedComponent)
+	{
+		Snapshot.Location = UpdatedComponent->GetComponentLocation();
+		Snapshot.Rotation = UpdatedComponent->GetComponentQuat();
+	}
+
+	Snapshot.Velocity = Velocity;
+	Snapshot.SurfaceFriction = SurfaceFriction;
+	Snapshot.MaxStepHeight = MaxStepHeight;
+	Snapshot.WalkableFloorZ = GetWalkableFloorZ();
+	Snapshot.TimeAccumulator = DeterministicTimeAccumulator;
+	Snapshot.Tick = DeterministicTick;
+	Snapshot.MovementMode = MovementMode;
+	Snapshot.CustomMovementMode = CustomMovementMode;
+	Snapshot.bBrakingFrameTolerated = bBrakingFrameTolerated;
+
+	return Snapshot;
+}
+
+void UAlphaMovementConfig::RestoreSnapshot(const FAlphaMovementSnapshot& Snapshot)
+{
+	if (!HasValidData())
+		return;
+
+	UpdatedComponent->SetWorldLocationAndRotation(Snapshot.Location, Snapshot.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+
+	// assigned directly, SetMovementMode would fire mode change side effects for a state we already went through
+	Velocity = Snapshot.Velocity;
+	SurfaceFriction = Snapshot.SurfaceFriction;
+	MaxStepHeight = Snapshot.MaxStepHeight;
+	SetWalkableFloorZ(Snapshot.WalkableFloorZ);
+	DeterministicTimeAccumulator = Snapshot.TimeAccumulator;
+	DeterministicTick = Snapshot.Tick;
+	MovementMode = static_cast<EMovementMode>(Snapshot.MovementMode);
+	CustomMovementMode = Snapshot.CustomMovementMode;
+	bBrakingFrameTolerated = Snapshot.bBrakingFrameTolerated;
+
+	if (IsMovingOnGround())
+		FindFloor(UpdatedComponent->GetComponentLocation(), CurrentFloor, false);
+	else
+		CurrentFloor.Clear();
+}
+
+void UAlphaMovementConfig::ResetForRespawn()
+{
+	if (!HasValidData())
+		return;
+
+	StopMovementImmediately();
+	ClearAccumulatedForces();
+	SetDefaultMovementMode();
+
+	SurfaceFriction = 1.0f;
+	MaxStepHeight = DefaultStepHeight;
+	SetWalkableFloorZ(DefaultWalkableFloorZ);
+	bBrakingFrameTolerated = true;
+	bHasPrecomputedVelocity = false;
+	PendingValidation = FAlphaMoveValidationSample();
+	bHasClaimedLocation = false;
+	bForceMoveCorrection = false;
+	DeferredServerMoves.Reset();
+	bHasUncrouchClearance = false;
+	bWantsToCrouch = false;
+	ActiveZone = FAlphaMovementZoneSettings();
+	MovementTier = EAlphaMovementTier::Full;
+	bProxyRateReduced = false;
+	bAlwaysCheckFloor = bDefaultAlwaysCheckFloor;
+	DeterministicTimeAccumulator = 0.0f;
+	PendingStepAcceleration = FVector::ZeroVector;
+
+	// caches refer to the old position, buffers keep their allocation
+	FloorCache.Reset();
+	ProxySmoother.Reset();
+	LastProxyServerTime = 0.0f;
+	LastProxyLocalTime = 0.0f;
+	bFloorQueryParamsValid = false;
+	FrictionFloor.Reset();
+
+	if (IsAsyncPhysicsMovementActive())
+		AsyncMovement.Reset();
+}
+
+void UAlphaMovementConfig::SimulateDeterministicStep(const FVector& InputVector, bool bJump)
+{
+	if (!HasValidData())
+		return;
+
+	const float TimeStep = FMath::Max(DeterministicTimeStep, MIN_TICK_TIME);
+	TGuardValue<bool> GuardResimulating(bResimulating, true);
+
+	BeginDeterministicStep();
+
+	// same order as ControlledCharacterMove
+	CharacterOwner->bPressedJump = bJump;
+	CharacterOwner->CheckJumpInput(TimeStep);
+	Acceleration = ScaleInputAcceleration(ConstrainInputAcceleration(InputVector));
+	AnalogInputModifier = ComputeAnalogInputModifier();
+
+	PerformMovement(TimeStep);
+	CharacterOwner->ClearJumpInput(TimeStep);
+
+	EndDeterministicStep();
+}
+
+void UAlphaMovementConfig::AsyncPhysicsTickComponent(float DeltaTime, float SimTime)
+{
+	Super::AsyncPhysicsTickComponent(DeltaTime, SimTime);
+
+	if (!IsAsyncPhysicsMovementActive())
+		return;
+
+	// restart from the latest game thread state, it includes everything collision did to the velocity
+	if (AsyncMovement.PopInput(AsyncInput))
+	{
+		bHasAsyncInput = AsyncInput.bStepping;
+		AsyncVelocity = AsyncInput.State.Velocity;
+	}
+
+	if (!bHasAsyncInput)
+		return;
+
+	FAlphaAsyncMovementStep Step;
+	Step.Input = AsyncInput.State;
+	Step.Input.Velocity = AsyncVelocity;
+	Step.Input.DeltaTime = DeltaTime;
+	Step.BaseSequence = AsyncInput.Sequence;
+
+	FAlphaVelocityKernel::Calculate(AsyncInput.Tuning, Step.Input, Step.Result);
+
+	AsyncVelocity = Step.Result.Velocity;
+	AsyncMovement.PushStep(Step);
+}
+
+void UAlphaMovementConfig::PushAsyncMovementState()
+{
+	FAlphaAsyncMovementInput Input;
+	Input.Sequence = ++AsyncSequence;
+
+	// the kernel only covers walking and falling, anything else stops the physics tick from stepping
+	if (!IsMovingOnGround() && !IsFalling())
+	{
+		Input.bStepping = false;
+		AsyncMovement.PushInput(Input);
+		return;
+	}
+
+	// same inputs PhysWalking and PhysFalling give CalcVelocity, with the acceleration from this frame's input
+	Input.Tuning = GetVelocityTuning();
+	Input.State.Velocity = FVector(Velocity.X, Velocity.Y, 0.0f);
+	Input.State.Acceleration = FVector(Acceleration.X, Acceleration.Y, 0.0f);
+	Input.State.Friction = FMath::Max(0.0f, IsFalling() ? FallingLateralFriction : GroundFriction);
+	Input.State.BrakingDeceleration = GetMaxBrakingDeceleration();
+	Input.State.MaxSpeed = FMath::Max(GetMaxSpeed() * AnalogInputModifier, GetMinAnalogSpeed());
+	Input.State.SurfaceFriction = SurfaceFriction;
+	Input.State.bGroundMove = IsMovingOnGround() && bBrakingFrameTolerated;
+	Input.State.bFalling = IsFalling();
+
+	AsyncMovement.PushInput(Input);
+}
+
+bool UAlphaMovementConfig::ShouldUseAsyncPhysicsSteps() const
+{
+	return CharacterOwner && CharacterOwner->IsLocallyControlled() && !CharacterOwner->bClientUpdating && !bResimulating;
+}
+
+void UAlphaMovementConfig::ConsumeAsyncVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output)
+{
+	Output.Velocity = Input.Velocity;
+	Output.Acceleration = Input.Acceleration.GetClampedToMaxSize2D(Input.MaxSpeed);
+
+	AsyncMovement.PopSteps(AsyncSteps);
+
+	// every step the physics tick took since the last update, in order, each applied exactly once
+	for (const FAlphaAsyncMovementStep& Step : AsyncSteps)
+	{
+		// the physics copy is still in line with ours, its result is exact
+		if (!Step.bMerged && Step.BaseSequence == AsyncSequence && Step.Input.Velocity.X == Output.Velocity.X && Step.Input.Velocity.Y == Output.Velocity.Y)
+		{
+			Output.Velocity.X = Step.Result.Velocity.X;
+			Output.Velocity.Y = Step.Result.Velocity.Y;
+			continue;
+		}
+
+		// stepped from an older state or the velocity changed since (collision, teleports, launches), redo the
+		// step from where we are with the input it was taken with
+		FAlphaVelocityInput StepInput = Step.Input;
+		StepInput.Velocity = FVector(Output.Velocity.X, Output.Velocity.Y, 0.0f);
+
+		FAlphaVelocityOutput StepOutput;
+		FAlphaVelocityKernel::Calculate(Tuning, StepInput, StepOutput);
+
+		Output.Velocity.X = StepOutput.Velocity.X;
+		Output.Velocity.Y = StepOutput.Velocity.Y;
+	}
+}
+
+void UAlphaMovementConfig::SubstepAsyncVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output) const
+{
+	const float StepTime = FMath::Max(UPhysicsSettings::Get()->AsyncFixedTimeStepSize, MIN_TICK_TIME);
+	const int32 NumSteps = FMath::Clamp(FMath::RoundToInt(Input.DeltaTime / StepTime), 1, FMath::CeilToInt(MaxSimulationTimeStep / StepTime));
+
+	FAlphaVelocityInput StepInput = Input;
+	StepInput.DeltaTime = Input.DeltaTime / NumSteps;
+
+	Output.Velocity = Input.Velocity;
+	Output.Acceleration = Input.Acceleration.GetClampedToMaxSize2D(Input.MaxSpeed);
+
+	for (int32 Step = 0; Step < NumSteps; Step++)
+	{
+		FAlphaVelocityKernel::Calculate(Tuning, StepInput, Output);
+		StepInput.Velocity = Output.Velocity;
+	}
 }
 
 bool UAlphaMovementConfig::DoJump(bool bReplayingMoves)
@@ -122,174 +760,844 @@ bool UAlphaMovementConfig::DoJump(bool bReplayingMoves)
 		else
 			Velocity.Z = JumpZVelocity;
 
+		const EMovementMode PreviousMode = MovementMode;
 		SetMovementMode(MOVE_Falling);
+		PublishMovementEvent(EAlphaMovementEventType::Jumped, CurrentFloor.HitResult, SurfaceFriction, PreviousMode);
 		return true;
 	}
 
 	return false;
 }
 
-void UAlphaMovementConfig::TwoWallAdjust(FVector& Delta, const FHitResult& Hit, const FVector& OldHitNormal) const
+void UAlphaMovementConfig::Crouch(bool bClientSimulation)
 {
-	Super::TwoWallAdjust(Delta, Hit, OldHitNormal);
-}
+	const bool bAirCrouch = !bClientSimulation && IsFalling() && !IsCrouching();
+	const float OldHalfHeight = CharacterOwner ? CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.0f;
 
-float UAlphaMovementConfig::SlideAlongSurface(const FVector& Delta, float Time, const FVector& Normal, FHitResult& Hit, bool bHandleImpact)
-{
-	return Super::SlideAlongSurface(Delta, Time, Normal, Hit, bHandleImpact);
-}
+	Super::Crouch(bClientSimulation);
 
-FVector UAlphaMovementConfig::ComputeSlideVector(const FVector& Delta, const float Time, const FVector& Normal, const FHitResult& Hit) const
-{
-	return Super::ComputeSlideVector(Delta, Time, Normal, Hit);
+	if (!bAirCrouch || !IsCrouching())
+		return;
+
+	// ducking in the air pulls the legs up, the top of the capsule stays where it was
+	const float HalfHeightAdjust = OldHalfHeight - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	UpdatedComponent->MoveComponent(FVector(0.0f, 0.0f, HalfHeightAdjust), UpdatedComponent->GetComponentQuat(), true, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
 }
 
-FVector UAlphaMovementConfig::HandleSlopeBoosting(const FVector& SlideResult, const FVector& Delta, const float Time, const FVector& Normal, const FHitResult& Hit) const
+void UAlphaMovementConfig::UnCrouch(bool bClientSimulation)
 {
-	const float WallAngle = FMath::Abs(Hit.ImpactNormal.Z);
-	FVector ImpactNormal;
+	if (bClientSimulation || !HasValidData() || !IsCrouching())
+	{
+		Super::UnCrouch(bClientSimulation);
+		return;
+	}
 
-	// cap normal if too extreme
-	if (WallAngle <= VERTICAL_SLOPE_NORMAL_Z || WallAngle == 1.0f)
-		ImpactNormal = Normal;
-	else
-		ImpactNormal = Hit.ImpactNormal;
+	const FVector Location = UpdatedComponent->GetComponentLocation();
+	const float CrouchedHalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float StandingHalfHeight = CharacterOwner->GetClass()->GetDefaultObject<ACharacter>()->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float Radius = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
 
-	if (bConstrainToPlane)
-		ImpactNormal = ConstrainNormalToPlane(ImpactNormal);
+	// on the ground the capsule grows up from its base, in the air it extends the legs and keeps its top
+	const bool bGrowsUp = !IsFalling();
+	const float StandingTop = Location.Z - CrouchedHalfHeight + 2.0f * StandingHalfHeight;
+
+	if (bHasUncrouchClearance && FVector::DistSquared2D(Location, UncrouchClearanceLocation) > FMath::Square(Radius))
+		bHasUncrouchClearance = false;
+
+	// still under the ceiling that blocked the last attempt, nothing to test
+	if (bGrowsUp && bHasUncrouchClearance && StandingTop > UncrouchCeilingZ)
+		return;
+
+	if (!bGrowsUp)
+	{
+		const float HalfHeightAdjust = StandingHalfHeight - CrouchedHalfHeight;
+		UpdatedComponent->MoveComponent(FVector(0.0f, 0.0f, -HalfHeightAdjust), UpdatedComponent->GetComponentQuat(), true, nullptr, EMoveComponentFlags::MOVECOMP_NoFlags, ETeleportType::TeleportPhysics);
+	}
+
+	Super::UnCrouch(false);
+
+	if (!IsCrouching())
+	{
+		bHasUncrouchClearance = false;
+		return;
+	}
+
+	UpdatedComponent->SetWorldLocation(Location, false, nullptr, ETeleportType::TeleportPhysics);
+
+	if (bGrowsUp)
+		MeasureUncrouchClearance(Location, StandingTop);
+}
+
+void UAlphaMovementConfig::MeasureUncrouchClearance(const FVector& Location, float StandingTop)
+{
+	const float CrouchedHalfHeight = CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const float Reach = StandingTop - (Location.Z + CrouchedHalfHeight);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AlphaUncrouchClearance), false, CharacterOwner);
+	FCollisionResponseParams ResponseParams;
+	InitCollisionParams(QueryParams, ResponseParams);
+
+	// one sweep of the crouched capsule up to standing height, instead of a standing overlap test every tick
+	FHitResult Hit;
+	GetWorld()->SweepSingleByChannel(Hit, Location, Location + FVector(0.0f, 0.0f, Reach), UpdatedComponent->GetComponentQuat(), UpdatedComponent->GetCollisionObjectType(), GetPawnCapsuleCollisionShape(SHRINK_None), QueryParams, ResponseParams);
+
+	// a ceiling that can move away has to be tested again every time
+	const UPrimitiveComponent* Ceiling = Hit.GetComponent();
+	bHasUncrouchClearance = Hit.bBlockingHit && !Hit.bStartPenetrating && Ceiling && Ceiling->Mobility == EComponentMobility::Static;
+
+	if (!bHasUncrouchClearance)
+		return;
+
+	// kept under the standing top, the overlap test that just failed already proved it blocks from here
+	UncrouchClearanceLocation = Location;
+	UncrouchCeilingZ = FMath::Min(Hit.Location.Z + CrouchedHalfHeight, StandingTop - KINDA_SMALL_NUMBER);
+}
+
+FVector UAlphaMovementConfig::GetClipNormal(const FHitResult& Hit) const
+{
+	const float WallAngle = FMath::Abs(Hit.ImpactNormal.Z);
+	const FVector Normal = WallAngle <= VERTICAL_SLOPE_NORMAL_Z || WallAngle == 1.0f ? Hit.Normal : Hit.ImpactNormal;
+
+	return bConstrainToPlane ? ConstrainNormalToPlane(Normal) : Normal;
+}
+
+bool UAlphaMovementConfig::ClipFallingMove(FHitResult& Hit, const FVector& OldLocation, const FQuat& PawnRotation, float Tick, float TimeRemaining, float& RemainingTime, int32 Iterations)
+{
+	const FVector PrimalVelocity = Velocity;
+	const float Overbounce = FMath::Max(1.0f + CamBounceModifier * (1.0f - SurfaceFriction), 1.0f);
+
+	// same as Quake's ClipVelocity, an overbounce above 1 pushes off ramps
+	auto ClipVelocity = [Overbounce](const FVector& InVelocity, const FVector& Normal)
+	{
+		const float Backoff = InVelocity | Normal;
+		return InVelocity - Normal * (Backoff < 0.0f ? Backoff * Overbounce : Backoff / Overbounce);
+	};
+
+	// the original direction counts as a plane so the velocity never turns back on itself
+	FVector Planes[MAX_CLIP_PLANES];
+	int32 NumPlanes = 0;
+	Planes[NumPlanes++] = PrimalVelocity.GetSafeNormal();
+
+	const int32 MaxBumps = MovementTier >= EAlphaMovementTier::ReducedIterations ? REDUCED_CLIP_BUMPS : MAX_CLIP_BUMPS;
+
+	for (int32 Bump = 0; Bump < MaxBumps && TimeRemaining > KINDA_SMALL_NUMBER; Bump++)
+	{
+		// an impact moved the character somewhere else, the planes and the velocity are no longer about this spot
+		if (bJustTeleported)
+			return false;
+
+		const FVector Normal = GetClipNormal(Hit);
+		bool bSamePlane = false;
+
+		// hit the same plane again, nudge off it instead of clipping into the same crease
+		for (int32 Index = 0; Index < NumPlanes; Index++)
+		{
+			if ((Normal | Planes[Index]) > 0.99f)
+			{
+				Velocity += Normal;
+				bSamePlane = true;
+				break;
+			}
+		}
+
+		if (!bSamePlane)
+		{
+			if (NumPlanes >= MAX_CLIP_PLANES)
+			{
+				Velocity = FVector::ZeroVector;
+				return false;
+			}
+
+			Planes[NumPlanes++] = Normal;
+
+			// find a plane to clip against which doesn't push the velocity into the others
+			for (int32 First = 0; First < NumPlanes; First++)
+			{
+				if ((Velocity | Planes[First]) >= CLIP_PLANE_TOLERANCE)
+					continue;
+
+				FVector Clipped = ClipVelocity(Velocity, Planes[First]);
+
+				for (int32 Second = 0; Second < NumPlanes; Second++)
+				{
+					if (Second == First || (Clipped | Planes[Second]) >= CLIP_PLANE_TOLERANCE)
+						continue;
+
+					Clipped = ClipVelocity(Clipped, Planes[Second]);
+
+					if ((Clipped | Planes[First]) >= 0.0f)
+						continue;
+
+					// in a corner of two planes, slide along the crease
+					const FVector Crease = FVector::CrossProduct(Planes[First], Planes[Second]).GetSafeNormal();
+					Clipped = Crease * (Crease | Velocity);
+
+					// a third plane closes the corner
+					for (int32 Third = 0; Third < NumPlanes; Third++)
+					{
+						if (Third == First || Third == Second || (Clipped | Planes[Third]) >= CLIP_PLANE_TOLERANCE)
+							continue;
+
+						Velocity = FVector::ZeroVector;
+						return false;
+					}
+				}
+
+				Velocity = Clipped;
+				break;
+			}
+		}
+
+		// turned back against the original direction, stop instead of oscillating in the corner
+		if ((Velocity | PrimalVelocity) <= 0.0f)
+		{
+			Velocity = FVector::ZeroVector;
+			return false;
+		}
+
+		const FVector OldHitNormal = Hit.Normal;
+		const FVector OldHitImpactNormal = Hit.ImpactNormal;
+		const FVector Delta = Velocity * TimeRemaining;
+		SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
+
+		if (!HasValidData())
+			return true;
+
+		if (!Hit.bBlockingHit)
+		{
+			NudgeOffPerch(OldLocation, OldHitImpactNormal, PawnRotation, Tick, Hit);
+			return false;
+		}
+
+		const float MoveTime = TimeRemaining * Hit.Time;
+		TimeRemaining -= MoveTime;
+
+		if (IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit))
+		{
+			RemainingTime += TimeRemaining;
+			ProcessLanded(Hit, RemainingTime, Iterations);
+			return true;
+		}
+
+		// same as PhysFalling, a level move stuck between two floors it can't stand on (a ditch) lands in it
+		const bool bInDitch = OldHitImpactNormal.Z > 0.0f && Hit.ImpactNormal.Z > 0.0f && FMath::Abs(Delta.Z) <= KINDA_SMALL_NUMBER && (Hit.ImpactNormal | OldHitImpactNormal) < 0.0f;
+
+		// wedged without moving at all, nudge sideways out of it first
+		if (Hit.Time == 0.0f)
+		{
+			FVector SideDelta = (OldHitNormal + Hit.ImpactNormal).GetSafeNormal2D();
+
+			if (SideDelta.IsNearlyZero())
+				SideDelta = FVector(OldHitNormal.Y, -OldHitNormal.X, 0.0f).GetSafeNormal();
+
+			SafeMoveUpdatedComponent(SideDelta, PawnRotation, true, Hit);
+
+			if (!HasValidData())
+				return true;
+		}
+
+		if (bInDitch || Hit.Time == 0.0f)
+		{
+			RemainingTime = 0.0f;
+			ProcessLanded(Hit, RemainingTime, Iterations);
+			return true;
+		}
+
+		// the side nudge got clear, the rest of the step starts over from there
+		if (!Hit.bBlockingHit)
+			return false;
+
+		HandleImpact(Hit, MoveTime, Delta);
+
+		if (!HasValidData() || !IsFalling())
+			return true;
+	}
+
+	return false;
+}
+
+void UAlphaMovementConfig::NudgeOffPerch(const FVector& OldLocation, const FVector& PerchNormal, const FQuat& PawnRotation, float Tick, FHitResult& Hit)
+{
+	if (GetPerchRadiusThreshold() <= 0.0f || PerchNormal.Z < GetWalkableFloorZ())
+		return;
+
+	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
+	const float ZDistance = FMath::Abs(PawnLocation.Z - OldLocation.Z);
+	const float MoveDist2DSQ = (PawnLocation - OldLocation).SizeSquared2D();
+
+	// same as PhysFalling, balanced on an edge too narrow to perch on without getting anywhere, hop off it
+	if (ZDistance > 0.2f * Tick || MoveDist2DSQ > 4.0f * Tick)
+		return;
+
+	Velocity.X += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
+	Velocity.Y += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
+	Velocity.Z = FMath::Max<float>(JumpZVelocity * 0.25f, 1.0f);
+	SafeMoveUpdatedComponent(Velocity * Tick, PawnRotation, true, Hit);
+}
+
+void UAlphaMovementConfig::TwoWallAdjust(FVector& Delta, const FHitResult& Hit, const FVector& OldHitNormal) const
+{
+	Super::TwoWallAdjust(Delta, Hit, OldHitNormal);
+}
+
+float UAlphaMovementConfig::SlideAlongSurface(const FVector& Delta, float Time, const FVector& Normal, FHitResult& Hit, bool bHandleImpact)
+{
+	return Super::SlideAlongSurface(Delta, Time, Normal, Hit, bHandleImpact);
+}
+
+FVector UAlphaMovementConfig::ComputeSlideVector(const FVector& Delta, const float Time, const FVector& Normal, const FHitResult& Hit) const
+{
+	return Super::ComputeSlideVector(Delta, Time, Normal, Hit);
+}
+
+FVector UAlphaMovementConfig::HandleSlopeBoosting(const FVector& SlideResult, const FVector& Delta, const float Time, const FVector& Normal, const FHitResult& Hit) const
+{
+	const float WallAngle = FMath::Abs(Hit.ImpactNormal.Z);
+	FVector ImpactNormal;
+
+	// cap normal if too extreme
+	if (WallAngle <= VERTICAL_SLOPE_NORMAL_Z || WallAngle == 1.0f)
+		ImpactNormal = Normal;
+	else
+		ImpactNormal = Hit.ImpactNormal;
+
+	if (bConstrainToPlane)
+		ImpactNormal = ConstrainNormalToPlane(ImpactNormal);
+
+	const float BounceCoeff = 1.0f + CamBounceModifier * (1.0f - SurfaceFriction);
+	return (Delta - BounceCoeff * Delta.ProjectOnToNormal(ImpactNormal)) * Time;
+}
+
+bool UAlphaMovementConfig::ShouldCatchAir(const FFindFloorResult& OldFloor, const FFindFloorResult& NewFloor)
+{
+	const float OldSurfaceFriction = GetFrictionFromHit(OldFloor.HitResult);
+	const float SpeedMod = MaxSlopeSpeedModifier / Velocity.Size2D();
+	const float Diff = NewFloor.HitResult.ImpactNormal.Z - OldFloor.HitResult.ImpactNormal.Z;
+	const float Slope = Velocity | OldFloor.HitResult.ImpactNormal;
+	const float StrafeMovement = FMath::Abs(GetLastInputVector() | GetOwner()->GetActorRightVector());
+	
+	const bool bSliding = OldSurfaceFriction * SpeedMod < 0.5f;
+	const bool bGainingRamp = Diff >= 0.0f;
+	const bool bWasGoingUpRamp = Slope < 0.0f;
+	const bool bStrafingOffRamp = StrafeMovement > 0.0f;
+	const bool bMovingForCatchAir = bWasGoingUpRamp || bStrafingOffRamp;
+
+	if (bSliding && bGainingRamp && bMovingForCatchAir)
+	{
+		PublishMovementEvent(EAlphaMovementEventType::CatchAir, OldFloor.HitResult, OldSurfaceFriction, MovementMode);
+		return true;
+	}
+
+	return Super::ShouldCatchAir(OldFloor, NewFloor);
+}
+
+bool UAlphaMovementConfig::IsWithinEdgeTolerance(const FVector& CapsuleLocation, const FVector& TestImpactPoint, const float CapsuleRadius) const
+{
+	return Super::IsWithinEdgeTolerance(CapsuleLocation, TestImpactPoint, CapsuleRadius);
+}
+
+bool UAlphaMovementConfig::ShouldCheckForValidLandingSpot(float DeltaTime, const FVector& Delta, const FHitResult& Hit) const
+{
+	return !bUseFlatBaseForFloorChecks && Super::ShouldCheckForValidLandingSpot(DeltaTime, Delta, Hit);
+}
+
+bool UAlphaMovementConfig::IsValidLandingSpot(const FVector& CapsuleLocation, const FHitResult& Hit) const
+{
+	if (!Hit.bBlockingHit)
+		return false;
+
+	if (!Hit.bStartPenetrating)
+	{
+		if (!IsWalkable(Hit))
+			return false;
+
+		float PawnRadius;
+		float PawnHalfHeight;
+		float LowerHemisphereZ;
+
+		CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+
+		if (bUseFlatBaseForFloorChecks)
+		{
+			LowerHemisphereZ = Hit.Location.Z - PawnHalfHeight + MAX_FLOOR_DIST;
+			
+			if ((Hit.ImpactNormal.Z < GetWalkableFloorZ() || Hit.ImpactNormal.Z == 1.0f) && Hit.ImpactPoint.Z > LowerHemisphereZ)
+				return false;
+		}
+		else
+		{
+			LowerHemisphereZ = Hit.Location.Z - PawnHalfHeight + PawnRadius;
+
+			if (Hit.ImpactPoint.Z >= LowerHemisphereZ)
+				return false;
+		}
+
+		if (!IsWithinEdgeTolerance(Hit.Location, Hit.ImpactPoint, PawnRadius))
+			return false;
+	}
+	else if (Hit.Normal.Z < KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	FFindFloorResult FloorResult;
+	FindFloor(CapsuleLocation, FloorResult, false, &Hit);
+
+	if (!FloorResult.IsWalkableFloor())
+		return false;
+
+	if (Hit.Normal.Z < 1.0f && (Velocity | Hit.Normal) < 0.0f)
+	{
+		FVector DeflectVector = Velocity;
+		DeflectVector.Z += 0.5f * GetGravityZ() * GetWorld()->GetDeltaSeconds();
+		DeflectVector = ComputeSlideVector(DeflectVector, 1.0f, Hit.Normal, Hit);
+
+		if (DeflectVector.Z > JumpVelocity)
+			return false;
+	}
+
+	return true;
+}
+
+void UAlphaMovementConfig::InitFloorQueryParams()
+{
+	FloorQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(CharacterFloorTrace), false, CharacterOwner);
+	FloorResponseParams = FCollisionResponseParams();
+
+	InitCollisionParams(FloorQueryParams, FloorResponseParams);
+
+	FloorQueryParams.bTraceComplex = true;
+	FloorQueryParams.bReturnPhysicalMaterial = true;
+	bFloorQueryParamsValid = true;
+}
+
+void UAlphaMovementConfig::TraceCharacterFloor(FHitResult& OutHit)
+{
+	if (!bFloorQueryParamsValid)
+		InitFloorQueryParams();
+
+	const FCollisionShape StandingCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_None);
+	const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
+	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
+	FVector StandingLocation = PawnLocation;
+	
+	StandingLocation.Z -= MAX_FLOOR_DIST * 10.0f;
+
+	const bool bUseFloorCache = ShouldUseFloorCache();
+
+	if (bUseFloorCache && CharacterOwner->bClientUpdating && FloorCache.FindTrace(PawnLocation, OutHit))
+	{
+		FAlphaMovementCounters::Get().ReplayCacheHits++;
+		return;
+	}
+	
+	FAlphaMovementCounters::Get().FloorSweeps++;
+
+	GetWorld()->SweepSingleByChannel(
+		OutHit,
+		PawnLocation,
+		StandingLocation,
+		FQuat::Identity,
+		CollisionChannel,
+		StandingCapsuleShape,
+		FloorQueryParams,
+		FloorResponseParams
+	);
+
+	if (bUseFloorCache)
+		FloorCache.AddTrace(PawnLocation, OutHit);
+}
+
+void UAlphaMovementConfig::ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult) const
+{
+	// a passed in sweep result is already free
+	const bool bUseFloorCache = DownwardSweepResult == nullptr && ShouldUseFloorCache();
+
+	if (bUseFloorCache && CharacterOwner->bClientUpdating && FloorCache.FindFloor(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, OutFloorResult))
+	{
+		FAlphaMovementCounters::Get().ReplayCacheHits++;
+		return;
+	}
+
+	FAlphaMovementCounters::Get().FloorSweeps++;
+	Super::ComputeFloorDist(CapsuleLocation, LineDistance, SweepDistance, OutFloorResult, SweepRadius, DownwardSweepResult);
+
+	if (bUseFloorCache)
+		FloorCache.AddFloor(CapsuleLocation, LineDistance, SweepDistance, SweepRadius, OutFloorResult);
+}
+
+bool UAlphaMovementConfig::ShouldUseFloorCache() const
+{
+	return CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_AutonomousProxy && CVarReplayFloorCache.GetValueOnGameThread() != 0;
+}
+
+void UAlphaMovementConfig::OnTeleported()
+{
+	Super::OnTeleported();
+
+	// nothing cached around the old location is on the new path
+	FloorCache.Reset();
+	bHasClaimedLocation = false;
+	bHasUncrouchClearance = false;
+}
+
+void UAlphaMovementConfig::OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode)
+{
+	Super::OnClientCorrectionReceived(ClientData, TimeStamp, NewLocation, NewVelocity, NewBase, NewBaseBoneName, bHasBase, bBaseRelativePosition, ServerMovementMode);
+
+	// queries made on the mispredicted path can't answer the replay from the server's state
+	FloorCache.Reset();
+	bHasUncrouchClearance = false;
+}
+
+bool UAlphaMovementConfig::ClientUpdatePositionAfterServerUpdate()
+{
+	const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+
+	if (ClientData == nullptr || !ClientData->bUpdatePosition)
+		return Super::ClientUpdatePositionAfterServerUpdate();
+
+	const int32 NumMoves = ClientData->SavedMoves.Num();
+	const FAlphaMovementCounters Before = FAlphaMovementCounters::Get();
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
+
+	FAlphaMovementCounters& Counters = FAlphaMovementCounters::Get();
+	LastReplayCost = FAlphaMovementCounters();
+	LastReplayCost.Replays = 1;
+	LastReplayCost.ReplayedMoves = NumMoves;
+	LastReplayCost.ReplayCycles = FPlatformTime::Cycles64() - StartCycles;
+	LastReplayCost.ReplaySweeps = Counters.FloorSweeps - Before.FloorSweeps;
+	LastReplayCost.ReplayCacheHits = Counters.ReplayCacheHits - Before.ReplayCacheHits;
+	LastReplayCost.MoveSweeps = Counters.MoveSweeps - Before.MoveSweeps;
+
+	Counters.Replays++;
+	Counters.ReplayedMoves += NumMoves;
+	Counters.ReplayCycles += LastReplayCost.ReplayCycles;
+	Counters.ReplaySweeps += LastReplayCost.ReplaySweeps;
+
+	UE_LOG(LogTemp, Verbose, TEXT("UAlphaMovementConfig replayed %d moves in %.3fms, %llu floor sweeps, %llu cached"), NumMoves, FPlatformTime::ToMilliseconds64(LastReplayCost.ReplayCycles), LastReplayCost.ReplaySweeps.Load(), LastReplayCost.ReplayCacheHits.Load());
+
+	return bResult;
+}
+
+bool UAlphaMovementConfig::MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit, ETeleportType Teleport)
+{
+	if (!bSweep || Delta.IsNearlyZero())
+		return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+
+	FAlphaMovementCounters::Get().MoveSweeps++;
+
+	if (!bCapturingTick || TickCapture.Sweeps.Num() >= MAX_CAPTURED_SWEEPS)
+		return Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+
+	FAlphaCapturedSweep& Sweep = TickCapture.Sweeps.AddDefaulted_GetRef();
+	Sweep.Start = UpdatedComponent->GetComponentLocation();
+	Sweep.Delta = Delta;
+
+	const bool bResult = Super::MoveUpdatedComponentImpl(Delta, NewRotation, bSweep, OutHit, Teleport);
+
+	if (OutHit)
+	{
+		Sweep.ImpactNormal = OutHit->ImpactNormal;
+		Sweep.Time = OutHit->Time;
+		Sweep.bBlockingHit = OutHit->bBlockingHit;
+	}
+
+	return bResult;
+}
+
+void UAlphaMovementConfig::ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData)
+{
+	if (!ShouldDeferServerMoves())
+	{
+		PerformServerMove(MoveData);
+		return;
+	}
+
+	// keep the order, the oldest moves make room
+	if (DeferredServerMoves.Num() >= MAX_DEFERRED_SERVER_MOVES)
+		FlushDeferredServerMoves();
+
+	FDeferredServerMove& Move = DeferredServerMoves.AddDefaulted_GetRef();
+	Move.MoveData = MoveData;
+	Move.MovementBase = MoveData.MovementBase;
+	Move.bIgnoreRootMotion = CharacterOwner->bServerMoveIgnoreRootMotion;
+}
+
+bool UAlphaMovementConfig::IsMovedByServerMoves() const
+{
+	return CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_Authority && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy && !CharacterOwner->IsLocallyControlled();
+}
+
+bool UAlphaMovementConfig::ShouldDeferServerMoves() const
+{
+	// moves arrive before the velocity phase runs, only worth holding if it runs and the tick will pick them up.
+	// a custom move data container would be sliced by the copy, those moves are performed right away
+	return MovementBatch && MovementBatch->IsVelocityPhaseEnabled() && CharacterOwner && PrimaryComponentTick.IsTickFunctionEnabled() && !bDeterministicMovement && !IsAsyncPhysicsMovementActive()
+		&& &GetNetworkMoveDataContainer() == DefaultMoveDataContainer;
+}
+
+void UAlphaMovementConfig::PerformServerMove(const FCharacterNetworkMoveData& MoveData)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+
+	// a remote player's moves are its updates on the server, the tick itself doesn't move it
+	if (ServerData && ShouldCaptureSlowTicks())
+	{
+		BeginTickCapture(ServerData->GetServerMoveDeltaTime(MoveData.TimeStamp, CharacterOwner->GetActorTimeDilation()));
+
+		// there is no pending input for a remote player, the move's acceleration is turned back into the input
+		// vector which produces it when replayed
+		const float MaxAccel = GetMaxAcceleration();
+		TickCapture.InputVector = MaxAccel > SMALL_NUMBER ? ConstrainInputAcceleration(MoveData.Acceleration) / MaxAccel : FVector::ZeroVector;
+		TickCapture.ControlRotation = MoveData.ControlRotation;
+		TickCapture.bPressedJump = (MoveData.CompressedMoveFlags & FSavedMove_Character::FLAG_JumpPressed) != 0;
+		TickCapture.bWantsToCrouch = (MoveData.CompressedMoveFlags & FSavedMove_Character::FLAG_WantsToCrouch) != 0;
+	}
+
+	Super::ServerMove_PerformMovement(MoveData);
+
+	const uint64 MoveCycles = FPlatformTime::Cycles64() - StartCycles;
+
+	FAlphaMovementCounters& Counters = FAlphaMovementCounters::Get();
+	Counters.MovementCycles += MoveCycles;
+	Counters.MovementUpdates++;
+	Counters.AddSpeedSample(Velocity.Size());
+
+	FinishTickCapture(MoveCycles);
+}
+
+void UAlphaMovementConfig::FlushDeferredServerMoves()
+{
+	if (DeferredServerMoves.Num() == 0)
+		return;
+
+	// the engine reads the move being performed back through the current move data
+	for (FDeferredServerMove& Move : DeferredServerMoves)
+	{
+		if (!HasValidData())
+			break;
+
+		// the base may have been destroyed since the move arrived, the client gets corrected off it
+		Move.MoveData.MovementBase = Move.MovementBase.Get();
+
+		CharacterOwner->bServerMoveIgnoreRootMotion = Move.bIgnoreRootMotion;
+		SetCurrentNetworkMoveData(&Move.MoveData);
+		PerformServerMove(Move.MoveData);
+	}
+
+	if (CharacterOwner)
+		CharacterOwner->bServerMoveIgnoreRootMotion = false;
+
+	SetCurrentNetworkMoveData(nullptr);
+	DeferredServerMoves.Reset();
+}
+
+void UAlphaMovementConfig::ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits)
+{
+	FAlphaMovementCounters::Get().ServerMoveBytes += (PackedBits.DataBits.Num() + 7) / 8;
+
+	Super::ServerMovePacked_ServerReceive(PackedBits);
+}
+
+bool UAlphaMovementConfig::ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode)
+{
+	const bool bNeedsCorrection = Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode);
+
+	// the server's own simulation can't gain more than the model allows, the ground the client claims to cover can
+	if (MoveValidation && MovementBaseUtility::UseRelativeLocation(ClientMovementBase))
+	{
+		bHasClaimedLocation = false;
+		PendingValidation = FAlphaMoveValidationSample();
+	}
+	else if (MoveValidation)
+	{
+		if (bHasClaimedLocation && PendingValidation.NumUpdates > 0)
+			FlushMoveValidation(FVector::Dist2D(ClientWorldLocation, ClaimedLocation));
+
+		// a corrected client carries on from where the server put it
+		ClaimedLocation = bNeedsCorrection ? UpdatedComponent->GetComponentLocation() : ClientWorldLocation;
+		bHasClaimedLocation = true;
+		PendingValidation = FAlphaMoveValidationSample();
+	}
+
+	const bool bForcedCorrection = bForceMoveCorrection && !bNeedsCorrection;
+	bForceMoveCorrection = false;
+
+	if (bNeedsCorrection || bForcedCorrection)
+		FAlphaMovementCounters::Get().Corrections++;
+
+	return bNeedsCorrection || bForcedCorrection;
+}
+
+void UAlphaMovementConfig::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel)
+{
+	const EMovementMode PreviousMode = MovementMode;
+	const FVector PreviousVelocity = Velocity;
+
+	{
+		TGuardValue<float> GuardMoveTimeStamp(DeterministicMoveTimeStamp, ClientTimeStamp);
+		TGuardValue<bool> GuardHasMoveTimeStamp(bHasDeterministicMoveTimeStamp, true);
+		Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+	}
+
+	if (MoveValidation == nullptr || DeltaTime <= 0.0f)
+		return;
+
+	// only walking and falling follow the strafe model, noclip and custom modes aren't checked
+	const bool bPreviousModeChecked = PreviousMode == MOVE_Walking || PreviousMode == MOVE_Falling;
+	const bool bModeChecked = MovementMode == MOVE_Walking || MovementMode == MOVE_Falling;
 
-	const float BounceCoeff = 1.0f + CamBounceModifier * (1.0f - SurfaceFriction);
-	return (Delta - BounceCoeff * Delta.ProjectOnToNormal(ImpactNormal)) * Time;
-}
+	if (!bPreviousModeChecked || !bModeChecked)
+	{
+		bHasClaimedLocation = false;
+		return;
+	}
 
-bool UAlphaMovementConfig::ShouldCatchAir(const FFindFloorResult& OldFloor, const FFindFloorResult& NewFloor)
-{
-	const float OldSurfaceFriction = GetFrictionFromHit(OldFloor.HitResult);
-	const float SpeedMod = MaxSlopeSpeedModifier / Velocity.Size2D();
-	const float Diff = NewFloor.HitResult.ImpactNormal.Z - OldFloor.HitResult.ImpactNormal.Z;
-	const float Slope = Velocity | OldFloor.HitResult.ImpactNormal;
-	const float StrafeMovement = FMath::Abs(GetLastInputVector() | GetOwner()->GetActorRightVector());
-	
-	const bool bSliding = OldSurfaceFriction * SpeedMod < 0.5f;
-	const bool bGainingRamp = Diff >= 0.0f;
-	const bool bWasGoingUpRamp = Slope < 0.0f;
-	const bool bStrafingOffRamp = StrafeMovement > 0.0f;
-	const bool bMovingForCatchAir = bWasGoingUpRamp || bStrafingOffRamp;
+	// any part of the move spent on the ground accelerates with the ground limits
+	const bool bGroundMove = PreviousMode == MOVE_Walking || MovementMode == MOVE_Walking;
+	const float MaxSpeed = GetMaxSpeed();
+	const FAlphaVelocityTuning Tuning = GetVelocityTuning();
 
-	if (bSliding && bGainingRamp && bMovingForCatchAir)
-		return true;
+	// moves without a location of their own, like the first half of a dual move, add up until the next claim
+	if (PendingValidation.NumUpdates == 0)
+		PendingValidation.StartVelocity = PreviousVelocity;
 
-	return Super::ShouldCatchAir(OldFloor, NewFloor);
+	PendingValidation.DeltaTime += DeltaTime;
+	PendingValidation.NumUpdates++;
+	PendingValidation.Acceleration = FMath::Max(PendingValidation.Acceleration, MaxSpeed * (bGroundMove ? Tuning.GroundAccelerationModifier : Tuning.AirAccelerationModifier) * SurfaceFriction);
+	PendingValidation.SpeedCap = FMath::Max(PendingValidation.SpeedCap, bGroundMove ? MaxSpeed : Tuning.AirSpeedCap);
+	PendingValidation.ExtraSpeed += FMath::Abs(GetGravityZ()) * DeltaTime;
+
+	if (CompressedFlags & FSavedMove_Character::FLAG_JumpPressed)
+		PendingValidation.ExtraSpeed += JumpZVelocity;
 }
 
-bool UAlphaMovementConfig::IsWithinEdgeTolerance(const FVector& CapsuleLocation, const FVector& TestImpactPoint, const float CapsuleRadius) const
+void UAlphaMovementConfig::FlushMoveValidation(float ClaimedDistance)
 {
-	return Super::IsWithinEdgeTolerance(CapsuleLocation, TestImpactPoint, CapsuleRadius);
+	PendingValidation.ClaimedDistance = ClaimedDistance;
+	MoveValidation->AddSample(this, PendingValidation);
 }
 
-bool UAlphaMovementConfig::ShouldCheckForValidLandingSpot(float DeltaTime, const FVector& Delta, const FHitResult& Hit) const
+void UAlphaMovementConfig::CorrectInvalidMove(float AllowedSpeed)
 {
-	return !bUseFlatBaseForFloorChecks && Super::ShouldCheckForValidLandingSpot(DeltaTime, Delta, Hit);
+	Velocity = Velocity.GetClampedToMaxSize(AllowedSpeed);
+	bForceMoveCorrection = true;
 }
 
-bool UAlphaMovementConfig::IsValidLandingSpot(const FVector& CapsuleLocation, const FHitResult& Hit) const
+bool UAlphaMovementConfig::ShouldUseHermiteSmoothing() const
 {
-	if (!Hit.bBlockingHit)
-		return false;
+	return bUseHermiteProxySmoothing && NetworkSmoothingMode != ENetworkSmoothingMode::Disabled && CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy;
+}
 
-	if (!Hit.bStartPenetrating)
+void UAlphaMovementConfig::SmoothCorrection(const FVector& OldLocation, const FQuat& OldRotation, const FVector& NewLocation, const FQuat& NewRotation)
+{
+	if (!ShouldUseHermiteSmoothing())
 	{
-		if (!IsWalkable(Hit))
-			return false;
+		Super::SmoothCorrection(OldLocation, OldRotation, NewLocation, NewRotation);
+		return;
+	}
 
-		float PawnRadius;
-		float PawnHalfHeight;
-		float LowerHemisphereZ;
+	const float LocalTime = GetWorld()->GetTimeSeconds();
+	float ServerTime = CharacterOwner->GetReplicatedServerLastTransformUpdateTimeStamp();
 
-		CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(PawnRadius, PawnHalfHeight);
+	// without a server stamp the arrival time is the best guess
+	if (ServerTime <= 0.0f)
+		ServerTime = LocalTime;
 
-		if (bUseFlatBaseForFloorChecks)
-		{
-			LowerHemisphereZ = Hit.Location.Z - PawnHalfHeight + MAX_FLOOR_DIST;
-			
-			if ((Hit.ImpactNormal.Z < GetWalkableFloorZ() || Hit.ImpactNormal.Z == 1.0f) && Hit.ImpactPoint.Z > LowerHemisphereZ)
-				return false;
-		}
-		else
+	// a later update with the same stamp means the server doesn't send it with every update, the smoother would
+	// fold every state into one, so the stamp is carried forward by the arrival time instead
+	if (ServerTime <= LastProxyServerTime && LocalTime > LastProxyLocalTime)
+	{
+		if (!bWarnedStaleProxyTime)
 		{
-			LowerHemisphereZ = Hit.Location.Z - PawnHalfHeight + PawnRadius;
-
-			if (Hit.ImpactPoint.Z >= LowerHemisphereZ)
-				return false;
+			UE_LOG(LogTemp, Warning, TEXT("UAlphaMovementConfig %s received a transform update without a newer server timestamp, check bNetworkAlwaysReplicateTransformUpdateTimestamp"), *GetNameSafe(CharacterOwner));
+			bWarnedStaleProxyTime = true;
 		}
 
-		if (!IsWithinEdgeTolerance(Hit.Location, Hit.ImpactPoint, PawnRadius))
-			return false;
+		ServerTime = LastProxyServerTime + (LocalTime - LastProxyLocalTime);
 	}
-	else if (Hit.Normal.Z < KINDA_SMALL_NUMBER)
+
+	LastProxyServerTime = ServerTime;
+	LastProxyLocalTime = LocalTime;
+
+	// velocity is received before the transform, it already belongs to this state
+	ProxySmoother.AddSnapshot(ServerTime, LocalTime, NewLocation, Velocity, NewRotation, NetworkNoSmoothUpdateDistance);
+	bNetworkSmoothingComplete = false;
+}
+
+void UAlphaMovementConfig::SmoothClientPosition(float DeltaSeconds)
+{
+	if (!ShouldUseHermiteSmoothing())
 	{
-		return false;
+		Super::SmoothClientPosition(DeltaSeconds);
+		return;
 	}
 
-	FFindFloorResult FloorResult;
-	FindFloor(CapsuleLocation, FloorResult, false, &Hit);
+	USkeletalMeshComponent* Mesh = CharacterOwner->GetMesh();
 
-	if (!FloorResult.IsWalkableFloor())
-		return false;
+	if (Mesh == nullptr || Mesh->IsSimulatingPhysics())
+		return;
 
-	if (Hit.Normal.Z < 1.0f && (Velocity | Hit.Normal) < 0.0f)
-	{
-		FVector DeflectVector = Velocity;
-		DeflectVector.Z += 0.5f * GetGravityZ() * GetWorld()->GetDeltaSeconds();
-		DeflectVector = ComputeSlideVector(DeflectVector, 1.0f, Hit.Normal, Hit);
+	ProxySmoother.UpdateDelay(DeltaSeconds, MinProxySmoothingDelay, MaxProxySmoothingDelay);
 
-		if (DeflectVector.Z > JumpVelocity)
-			return false;
-	}
+	FVector RenderLocation;
+	FQuat RenderRotation;
 
-	return true;
-}
+	if (!ProxySmoother.Evaluate(GetWorld()->GetTimeSeconds(), RenderLocation, RenderRotation))
+		return;
 
-void UAlphaMovementConfig::TraceCharacterFloor(FHitResult& OutHit)
-{
-	FCollisionQueryParams CapsuleParams(SCENE_QUERY_STAT(CharacterFloorTrace), false, CharacterOwner);
-	FCollisionResponseParams ResponseParam;
-	
-	InitCollisionParams(CapsuleParams, ResponseParam);
-	
-	CapsuleParams.bTraceComplex = true;
-	CapsuleParams.bReturnPhysicalMaterial = true;
+	// the capsule follows the latest state, only the mesh is drawn on the curve
+	const FTransform& CapsuleTransform = UpdatedComponent->GetComponentTransform();
+	const FVector RelativeLocation = CapsuleTransform.InverseTransformVectorNoScale(RenderLocation - CapsuleTransform.GetLocation()) + CharacterOwner->GetBaseTranslationOffset();
+	const FQuat RelativeRotation = CapsuleTransform.GetRotation().Inverse() * RenderRotation * CharacterOwner->GetBaseRotationOffset();
 
-	const FCollisionShape StandingCapsuleShape = GetPawnCapsuleCollisionShape(SHRINK_None);
-	const ECollisionChannel CollisionChannel = UpdatedComponent->GetCollisionObjectType();
-	const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
-	FVector StandingLocation = PawnLocation;
-	
-	StandingLocation.Z -= MAX_FLOOR_DIST * 10.0f;
-	
-	GetWorld()->SweepSingleByChannel(
-		OutHit,
-		PawnLocation,
-		StandingLocation,
-		FQuat::Identity,
-		CollisionChannel,
-		StandingCapsuleShape,
-		CapsuleParams,
-		ResponseParam
-	);
+	Mesh->SetRelativeLocationAndRotation(RelativeLocation, RelativeRotation, false, nullptr, ETeleportType::TeleportPhysics);
 }
 
 void UAlphaMovementConfig::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
 {
-	bool bJumped = false;
-
-	if (PreviousMovementMode == MOVE_Walking && MovementMode == MOVE_Falling)
-		bJumped = true;
-
 	FHitResult Hit;
 	TraceCharacterFloor(Hit);
 
 	Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
+
+	PublishMovementEvent(EAlphaMovementEventType::ModeChanged, Hit, GetFrictionFromHit(Hit), PreviousMovementMode);
+}
+
+void UAlphaMovementConfig::ProcessLanded(const FHitResult& Hit, float remainingTime, int32 Iterations)
+{
+	// published first so the event carries the impact velocity
+	PublishMovementEvent(EAlphaMovementEventType::Landed, Hit, GetFrictionFromHit(Hit), MovementMode);
+
+	Super::ProcessLanded(Hit, remainingTime, Iterations);
+}
+
+void UAlphaMovementConfig::PublishMovementEvent(EAlphaMovementEventType Type, const FHitResult& Hit, float Friction, EMovementMode PreviousMode)
+{
+	if (bResimulating || (CharacterOwner && CharacterOwner->bClientUpdating))
+		return;
+
+	if (Type == EAlphaMovementEventType::Landed)
+		FAlphaMovementCounters::Get().Landings++;
+	else if (Type == EAlphaMovementEventType::CatchAir)
+		FAlphaMovementCounters::Get().CatchAirs++;
+
+	if (MovementEvents == nullptr)
+		return;
+
+	FAlphaMovementEvent Event;
+	Event.Type = Type;
+	Event.Character = AlphaCharacter;
+	Event.Hit = Hit;
+	Event.Velocity = Velocity;
+	Event.SurfaceFriction = Friction;
+	Event.PreviousMode = PreviousMode;
+	Event.NewMode = MovementMode;
+	MovementEvents->Publish(Event);
 }
 
 float UAlphaMovementConfig::GetCameraRoll()
@@ -315,42 +1623,7 @@ void UAlphaMovementConfig::ApplyVelocityBraking(float DeltaTime, float Friction,
 	if (Velocity.IsNearlyZero(0.1f) || !HasValidData() || HasAnimRootMotion() || DeltaTime < MIN_TICK_TIME)
 		return;
 
-	const float Speed = Velocity.Size2D();
-	const float FrictionFactor = FMath::Max(0.0f, BrakingFrictionFactor);
-
-	Friction = FMath::Max(0.0f, Friction * FrictionFactor);
-	{
-		BrakingDeceleration = FMath::Max(BrakingDeceleration, Speed);
-	}
-	BrakingDeceleration = FMath::Max(0.0f, BrakingDeceleration);
-
-	const bool bZeroFriction = FMath::IsNearlyZero(Friction);
-	const bool bZeroBraking = BrakingDeceleration == 0.0f;
-
-	if (bZeroFriction || bZeroBraking)
-		return;
-
-	const FVector OldVelocity = Velocity;
-	const FVector ReverseAcceleration = -Velocity.GetSafeNormal();
-	const float MaxStepTime = FMath::Clamp(BrakingSubStepTime, 1.0f / 75.0f, 1.0f / 20.0f);
-	float RemainingTime = DeltaTime;
-
-	while(RemainingTime >= MIN_TICK_TIME)
-	{
-		const float Delta = (RemainingTime > MaxStepTime ? FMath::Min(MaxStepTime, RemainingTime * 0.5f) : RemainingTime);
-		RemainingTime -= Delta;
-
-		Velocity += (Friction * BrakingDeceleration * ReverseAcceleration) * Delta;
-
-		if ((Velocity | OldVelocity) <= 0.0f)
-		{
-			Velocity = FVector::ZeroVector;
-			return;
-		}
-	}
-
-	if (Velocity.IsNearlyZero(KINDA_SMALL_NUMBER))
-		Velocity = FVector::ZeroVector;
+	Velocity = FAlphaVelocityKernel::ApplyBraking(GetVelocityTuning(), Velocity, DeltaTime, Friction, BrakingDeceleration);
 }
 
 bool UAlphaMovementConfig::ShouldLimitAirControl(float DeltaTime, const FVector& FallAcceleration) const
@@ -365,11 +1638,30 @@ FVector UAlphaMovementConfig::NewFallVelocity(const FVector& InitialVelocity, co
 	return FallVelocity;
 }
 
+void UAlphaMovementConfig::UpdateMovementZone()
+{
+	if (MovementZones == nullptr || !MovementZones->FindZone(UpdatedComponent->GetComponentLocation(), ActiveZone))
+		ActiveZone = FAlphaMovementZoneSettings();
+}
+
+void UAlphaMovementConfig::UpdateMovementTier()
+{
+	MovementTier = MovementBudget ? MovementBudget->GetMovementTier(this) : EAlphaMovementTier::Full;
+	bProxyRateReduced = MovementBudget && MovementBudget->IsProxyRateReduced(this);
+
+	// a character standing still on a static floor has nothing new to find under it
+	bAlwaysCheckFloor = bDefaultAlwaysCheckFloor && MovementTier < EAlphaMovementTier::ReducedIterations;
+
+	if (MovementTier != EAlphaMovementTier::Full)
+		FAlphaMovementCounters::Get().DegradedUpdates++;
+}
+
 void UAlphaMovementConfig::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 {
+	UpdateMovementTier();
+	UpdateMovementZone();
 	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
 	Velocity.Z = FMath::Clamp(Velocity.Z, -AxisSpeedLimit, AxisSpeedLimit);
-	// TODO: UpdateCrouching
 }
 
 void UAlphaMovementConfig::UpdateCharacterStateAfterMovement(float DeltaSeconds)
@@ -377,16 +1669,29 @@ void UAlphaMovementConfig::UpdateCharacterStateAfterMovement(float DeltaSeconds)
 	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
 	Velocity.Z = FMath::Clamp(Velocity.Z, -AxisSpeedLimit, AxisSpeedLimit);
 	UpdateSurfaceFriction();
-	// TODO: UpdateCrouching(DeltaSeconds, true);
 }
 
 void UAlphaMovementConfig::UpdateSurfaceFriction(bool bIsSliding)
 {
 	if (!IsFalling() && CurrentFloor.IsWalkableFloor())
 	{
+		const UPrimitiveComponent* Floor = CurrentFloor.HitResult.GetComponent();
+
+		if (ActiveZone.bOverrideSurfaceFriction)
+		{
+			SurfaceFriction = ActiveZone.SurfaceFriction;
+			FrictionFloor.Reset();
+			return;
+		}
+
+		// still on the floor friction was traced on, its material is assumed not to change across it
+		if (MovementTier >= EAlphaMovementTier::CachedFriction && Floor != nullptr && FrictionFloor.Get() == Floor)
+			return;
+
 		FHitResult Hit;
 		TraceCharacterFloor(Hit);
 		SurfaceFriction = GetFrictionFromHit(Hit);
+		FrictionFloor = Floor;
 	}
 	else
 	{
@@ -409,9 +1714,18 @@ void UAlphaMovementConfig::PhysFalling(float deltaTime, int32 Iterations)
 	const bool bHasLimitedAirControl = ShouldLimitAirControl(deltaTime, FallAcceleration);
 	float RemainingTime = deltaTime;
 
+	FAlphaMovementCounters& Counters = FAlphaMovementCounters::Get();
+	const uint64 StartSweeps = Counters.MoveSweeps;
+
+	ON_SCOPE_EXIT
+	{
+		Counters.FallingSweeps += Counters.MoveSweeps - StartSweeps;
+	};
+
 	while ((RemainingTime >= MIN_TICK_TIME) && (Iterations < MaxSimulationIterations))
 	{
 		Iterations++;
+		Counters.FallingSteps++;
 		float Tick = GetSimulationTimeStep(RemainingTime, Iterations);
 		RemainingTime -= Tick;
 
@@ -535,117 +1849,126 @@ void UAlphaMovementConfig::PhysFalling(float deltaTime, int32 Iterations)
 				if (!HasValidData() || !IsFalling())
 					return;
 
-				FVector VelocityNoAirControl = OldVelocity;
-				FVector AirControlAcceleration = Acceleration;
-
-				if (bHasLimitedAirControl)
+				// root motion that overrides velocity keeps the engine's slide, the solver would rewrite its velocity
+				if (bUseMultiPlaneClipping && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
 				{
-					{
-						TGuardValue<FVector> RestoreAcceleration(Acceleration, FVector::ZeroVector);
-						TGuardValue<FVector> RestoreVelocity(Velocity, OldVelocity);
+					if (ClipFallingMove(Hit, OldLocation, PawnRotation, Tick, SubTimeTickRemaining, RemainingTime, Iterations))
+						return;
+				}
+				else
+				{
+					FVector VelocityNoAirControl = OldVelocity;
+					FVector AirControlAcceleration = Acceleration;
 
-						Velocity.Z = 0.f;
-						CalcVelocity(Tick, FallingLateralFriction, false, MaxDeceleration);
-						VelocityNoAirControl = FVector(Velocity.X, Velocity.Y, Velocity.Z);
-						VelocityNoAirControl = NewFallVelocity(VelocityNoAirControl, Gravity, GravityTime);
-					}
+					if (bHasLimitedAirControl)
+					{
+						{
+							TGuardValue<FVector> RestoreAcceleration(Acceleration, FVector::ZeroVector);
+							TGuardValue<FVector> RestoreVelocity(Velocity, OldVelocity);
 
-					const bool bCheckLandingSpot = false;
-					const FVector AirControlDeltaVelocity = LimitAirControl(LastMoveTimeSlice, AirControlAcceleration, Hit, bCheckLandingSpot) * LastMoveTimeSlice;
-					AirControlAcceleration = (Velocity - VelocityNoAirControl) / Tick;
-					AdjustedVelocity = (VelocityNoAirControl + AirControlDeltaVelocity) * LastMoveTimeSlice;
-				}
+							Velocity.Z = 0.f;
+							CalcVelocity(Tick, FallingLateralFriction, false, MaxDeceleration);
+							VelocityNoAirControl = FVector(Velocity.X, Velocity.Y, Velocity.Z);
+							VelocityNoAirControl = NewFallVelocity(VelocityNoAirControl, Gravity, GravityTime);
+						}
 
-				const FVector OldHitNormal = Hit.Normal;
-				const FVector OldHitImpactNormal = Hit.ImpactNormal;
-				FVector Delta = ComputeSlideVector(AdjustedVelocity, 1.f - Hit.Time, OldHitNormal, Hit);
-				FVector DeltaStep = ComputeSlideVector(Velocity * Tick, 1.f - Hit.Time, OldHitNormal, Hit);
+						const bool bCheckLandingSpot = false;
+						const FVector AirControlDeltaVelocity = LimitAirControl(LastMoveTimeSlice, AirControlAcceleration, Hit, bCheckLandingSpot) * LastMoveTimeSlice;
+						AirControlAcceleration = (Velocity - VelocityNoAirControl) / Tick;
+						AdjustedVelocity = (VelocityNoAirControl + AirControlDeltaVelocity) * LastMoveTimeSlice;
+					}
 
-				if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && !bJustTeleported)
-				{
-					const FVector NewVelocity = (DeltaStep / SubTimeTickRemaining);
-					Velocity = HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocityWithIgnoreZAccumulate() ? FVector(Velocity.X, Velocity.Y, Velocity.Z) : NewVelocity;
-				}
+					const FVector OldHitNormal = Hit.Normal;
+					const FVector OldHitImpactNormal = Hit.ImpactNormal;
+					FVector Delta = ComputeSlideVector(AdjustedVelocity, 1.f - Hit.Time, OldHitNormal, Hit);
+					FVector DeltaStep = ComputeSlideVector(Velocity * Tick, 1.f - Hit.Time, OldHitNormal, Hit);
 
-				if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && (Delta | AdjustedVelocity) > 0.f)
-				{
-					SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
+					if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && !bJustTeleported)
+					{
+						const FVector NewVelocity = (DeltaStep / SubTimeTickRemaining);
+						Velocity = HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocityWithIgnoreZAccumulate() ? FVector(Velocity.X, Velocity.Y, Velocity.Z) : NewVelocity;
+					}
 
-					if (Hit.bBlockingHit)
+					if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && (Delta | AdjustedVelocity) > 0.f)
 					{
-						LastMoveTimeSlice = SubTimeTickRemaining;
-						SubTimeTickRemaining = SubTimeTickRemaining * (1.f - Hit.Time);
+						SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 
-						if (IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit))
+						if (Hit.bBlockingHit)
 						{
-							RemainingTime += SubTimeTickRemaining;
-							ProcessLanded(Hit, RemainingTime, Iterations);
-							return;
-						}
+							LastMoveTimeSlice = SubTimeTickRemaining;
+							SubTimeTickRemaining = SubTimeTickRemaining * (1.f - Hit.Time);
 
-						HandleImpact(Hit, LastMoveTimeSlice, Delta);
+							if (IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit))
+							{
+								RemainingTime += SubTimeTickRemaining;
+								ProcessLanded(Hit, RemainingTime, Iterations);
+								return;
+							}
 
-						if (!HasValidData() || !IsFalling())
-							return;
+							HandleImpact(Hit, LastMoveTimeSlice, Delta);
 
-						if (bHasLimitedAirControl && Hit.Normal.Z > VERTICAL_SLOPE_NORMAL_Z)
-						{
-							const FVector LastMoveNoAirControl = VelocityNoAirControl * LastMoveTimeSlice;
-							Delta = ComputeSlideVector(LastMoveNoAirControl, 1.f, OldHitNormal, Hit);
-						}
+							if (!HasValidData() || !IsFalling())
+								return;
 
-						FVector PreTwoWallDelta = Delta;
-						TwoWallAdjust(Delta, Hit, OldHitNormal);
+							if (bHasLimitedAirControl && Hit.Normal.Z > VERTICAL_SLOPE_NORMAL_Z)
+							{
+								const FVector LastMoveNoAirControl = VelocityNoAirControl * LastMoveTimeSlice;
+								Delta = ComputeSlideVector(LastMoveNoAirControl, 1.f, OldHitNormal, Hit);
+							}
 
-						if (bHasLimitedAirControl)
-						{
-							const bool bCheckLandingSpot = false;
-							const FVector AirControlDeltaVelocity = LimitAirControl(SubTimeTickRemaining, AirControlAcceleration, Hit, bCheckLandingSpot) * SubTimeTickRemaining;
+							FVector PreTwoWallDelta = Delta;
+							TwoWallAdjust(Delta, Hit, OldHitNormal);
 
-							if (FVector::DotProduct(AirControlDeltaVelocity, OldHitNormal) > 0.f)
-								Delta += (AirControlDeltaVelocity * SubTimeTickRemaining);
-						}
+							if (bHasLimitedAirControl)
+							{
+								const bool bCheckLandingSpot = false;
+								const FVector AirControlDeltaVelocity = LimitAirControl(SubTimeTickRemaining, AirControlAcceleration, Hit, bCheckLandingSpot) * SubTimeTickRemaining;
 
-						if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && !bJustTeleported)
-						{
-							const FVector NewVelocity = (Delta / SubTimeTickRemaining);
-							Velocity = HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocityWithIgnoreZAccumulate() ? FVector(Velocity.X, Velocity.Y, Velocity.Z) : NewVelocity;
-						}
+								if (FVector::DotProduct(AirControlDeltaVelocity, OldHitNormal) > 0.f)
+									Delta += (AirControlDeltaVelocity * SubTimeTickRemaining);
+							}
 
-						// mega complicated bool which means the player is stuck between two surfaces that they can not walk on (i.e, a "ditch")
-						bool bInDitch = ((OldHitImpactNormal.Z > 0.f) && (Hit.ImpactNormal.Z > 0.f) && (FMath::Abs(Delta.Z) <= KINDA_SMALL_NUMBER) && ((Hit.ImpactNormal | OldHitImpactNormal) < 0.f));
-						SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
+							if (SubTimeTickRemaining > KINDA_SMALL_NUMBER && !bJustTeleported)
+							{
+								const FVector NewVelocity = (Delta / SubTimeTickRemaining);
+								Velocity = HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocityWithIgnoreZAccumulate() ? FVector(Velocity.X, Velocity.Y, Velocity.Z) : NewVelocity;
+							}
 
-						if (Hit.Time == 0.f)
-						{
-							FVector SideDelta = (OldHitNormal + Hit.ImpactNormal).GetSafeNormal2D();
+							// mega complicated bool which means the player is stuck between two surfaces that they can not walk on (i.e, a "ditch")
+							bool bInDitch = ((OldHitImpactNormal.Z > 0.f) && (Hit.ImpactNormal.Z > 0.f) && (FMath::Abs(Delta.Z) <= KINDA_SMALL_NUMBER) && ((Hit.ImpactNormal | OldHitImpactNormal) < 0.f));
+							SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
 
-							if (SideDelta.IsNearlyZero())
-								SideDelta = FVector(OldHitNormal.Y, -OldHitNormal.X, 0).GetSafeNormal();
+							if (Hit.Time == 0.f)
+							{
+								FVector SideDelta = (OldHitNormal + Hit.ImpactNormal).GetSafeNormal2D();
 
-							SafeMoveUpdatedComponent(SideDelta, PawnRotation, true, Hit);
-						}
+								if (SideDelta.IsNearlyZero())
+									SideDelta = FVector(OldHitNormal.Y, -OldHitNormal.X, 0).GetSafeNormal();
 
-						if (bInDitch || IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit) || Hit.Time == 0.f)
-						{
-							RemainingTime = 0.f;
-							ProcessLanded(Hit, RemainingTime, Iterations);
-							return;
-						}
+								SafeMoveUpdatedComponent(SideDelta, PawnRotation, true, Hit);
+							}
 
-						if (GetPerchRadiusThreshold() > 0.f && Hit.Time == 1.f && OldHitImpactNormal.Z >= GetWalkableFloorZ())
-						{
-							const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
-							const float ZDistance = FMath::Abs(PawnLocation.Z - OldLocation.Z);
-							const float MoveDist2DSQ = (PawnLocation - OldLocation).SizeSquared2D();
+							if (bInDitch || IsValidLandingSpot(UpdatedComponent->GetComponentLocation(), Hit) || Hit.Time == 0.f)
+							{
+								RemainingTime = 0.f;
+								ProcessLanded(Hit, RemainingTime, Iterations);
+								return;
+							}
 
-							if (ZDistance <= 0.2f * Tick && MoveDist2DSQ <= 4.f * Tick)
+							if (GetPerchRadiusThreshold() > 0.f && Hit.Time == 1.f && OldHitImpactNormal.Z >= GetWalkableFloorZ())
 							{
-								Velocity.X += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
-								Velocity.Y += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
-								Velocity.Z = FMath::Max<float>(JumpZVelocity * 0.25f, 1.f);
-								Delta = Velocity * Tick;
-								SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
+								const FVector PawnLocation = UpdatedComponent->GetComponentLocation();
+								const float ZDistance = FMath::Abs(PawnLocation.Z - OldLocation.Z);
+								const float MoveDist2DSQ = (PawnLocation - OldLocation).SizeSquared2D();
+
+								if (ZDistance <= 0.2f * Tick && MoveDist2DSQ <= 4.f * Tick)
+								{
+									Velocity.X += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
+									Velocity.Y += 0.25f * GetMaxSpeed() * (RandomStream.FRand() - 0.5f);
+									Velocity.Z = FMath::Max<float>(JumpZVelocity * 0.25f, 1.f);
+									Delta = Velocity * Tick;
+									SafeMoveUpdatedComponent(Delta, PawnRotation, true, Hit);
+								}
 							}
 						}
 					}
@@ -706,42 +2029,29 @@ void UAlphaMovementConfig::CalcVelocity(float DeltaTime, float Friction, bool bF
 
 	MaxSpeed = FMath::Max(MaxSpeed * AnalogInputModifier, GetMinAnalogSpeed());
 
-	// Apply braking or deceleration
-	const bool bZeroAcceleration = Acceleration.IsNearlyZero();
-	const bool bIsGroundMove = IsMovingOnGround() && bBrakingFrameTolerated;
-
-	// Apply friction
-	if (bIsGroundMove)
-	{
-		const bool bVelocityOverMax = IsExceedingMaxSpeed(MaxSpeed);
-		const FVector OldVelocity = Velocity;
-
-		const float ActualBrakingFriction = (bUseSeparateBrakingFriction ? BrakingFriction : Friction) * SurfaceFriction;
-		ApplyVelocityBraking(DeltaTime, ActualBrakingFriction, BrakingDeceleration);
-
-		// Don't allow braking to lower us below max speed if we started above it.
-		if (bVelocityOverMax && Velocity.SizeSquared() < FMath::Square(MaxSpeed) && FVector::DotProduct(Acceleration, OldVelocity) > 0.0f)
-		{
-			Velocity = OldVelocity.GetSafeNormal() * MaxSpeed;
-		}
-	}
-
-	// Apply fluid friction
-	if (bFluid)
-	{
-		Velocity = Velocity * (1.0f - FMath::Min(Friction * DeltaTime, 1.0f));
-	}
-
-	// Limit before
-	Velocity.X = FMath::Clamp(Velocity.X, -AxisSpeedLimit, AxisSpeedLimit);
-	Velocity.Y = FMath::Clamp(Velocity.Y, -AxisSpeedLimit, AxisSpeedLimit);
+	FAlphaVelocityInput Input;
+	Input.Velocity = Velocity;
+	Input.Acceleration = Acceleration;
+	Input.DeltaTime = DeltaTime;
+	Input.Friction = Friction;
+	Input.BrakingDeceleration = BrakingDeceleration;
+	Input.MaxSpeed = MaxSpeed;
+	Input.SurfaceFriction = SurfaceFriction;
+	Input.bFluid = bFluid;
+	Input.bGroundMove = IsMovingOnGround() && bBrakingFrameTolerated;
+	Input.bFalling = IsFalling();
+
+	const FAlphaVelocityTuning Tuning = GetVelocityTuning();
+	FAlphaVelocityOutput Output;
 
 	// no clip
 	if (bCheatFlying)
 	{
-		if (bZeroAcceleration)
+		Output.Acceleration = Acceleration;
+
+		if (Acceleration.IsNearlyZero())
 		{
-			Velocity = FVector(0.0f);
+			Output.Velocity = FVector(0.0f);
 		}
 		else
 		{
@@ -752,62 +2062,39 @@ void UAlphaMovementConfig::CalcVelocity(float DeltaTime, float Friction, bool bF
 			auto TangentialAccel = Acceleration - PerpendicularAccel;
 			auto UnitAcceleration = Acceleration;
 			auto Dir = UnitAcceleration.CosineAngle2D(LookVec);
-			auto NoClipAccelClamp = AlphaCharacter->IsWalking() ? MaxAcceleration : 2.0f * MaxAcceleration; // inverted until we add crouch
-			Velocity = (Dir * LookVec * PerpendicularAccel.Size2D() + TangentialAccel).GetClampedToSize(NoClipAccelClamp, NoClipAccelClamp);
+			auto NoClipAccelClamp = bWantsToCrouch ? MaxAcceleration : (AlphaCharacter->IsWalking() ? 4.0f : 2.0f) * MaxAcceleration;
+			Output.Velocity = (Dir * LookVec * PerpendicularAccel.Size2D() + TangentialAccel).GetClampedToSize(NoClipAccelClamp, NoClipAccelClamp);
 		}
+
+		FAlphaVelocityKernel::ApplySpeedLimits(Tuning, Input, Output);
 	}
-	// walk move
-	else
+	// stepped at the fixed rate by the async physics tick
+	else if (IsAsyncPhysicsMovementActive())
 	{
-		// Apply input acceleration
-		if (!bZeroAcceleration)
-		{
-			// Clamp acceleration to max speed
-			Acceleration = Acceleration.GetClampedToMaxSize2D(MaxSpeed);
-			// Find veer
-			const FVector AccelDir = Acceleration.GetSafeNormal2D();
-			const float Veer = Velocity.X * AccelDir.X + Velocity.Y * AccelDir.Y;
-			// Get add speed with air speed cap
-			const float AddSpeed = (bIsGroundMove ? Acceleration : Acceleration.GetClampedToMaxSize2D(AirSpeedCap)).Size2D() - Veer;
-			if (AddSpeed > 0.0f)
-			{
-				// Apply acceleration
-				const float AccelerationMultiplier = bIsGroundMove ? GroundAccelerationModifier : AirAccelerationModifier;
-				FVector CurrentAcceleration = Acceleration * AccelerationMultiplier * SurfaceFriction * DeltaTime;
-				CurrentAcceleration = CurrentAcceleration.GetClampedToMaxSize2D(AddSpeed);
-				Velocity += CurrentAcceleration;
-			}
-		}
-	}
-
-	// Limit after
-	Velocity.X = FMath::Clamp(Velocity.X, -AxisSpeedLimit, AxisSpeedLimit);
-	Velocity.Y = FMath::Clamp(Velocity.Y, -AxisSpeedLimit, AxisSpeedLimit);
-
-	const float SpeedSq = Velocity.SizeSquared2D();
+		if (ShouldUseAsyncPhysicsSteps())
+			ConsumeAsyncVelocity(Tuning, Input, Output);
+		else
+			SubstepAsyncVelocity(Tuning, Input, Output);
 
-	// Dynamic step height code for allowing sliding on a slope when at a high speed
-	if (SpeedSq <= MaxWalkSpeedCrouched * MaxWalkSpeedCrouched)
+		FAlphaVelocityKernel::ApplySpeedLimits(Tuning, Input, Output);
+	}
+	// computed by the parallel velocity phase, the zone is resolved after the gather and may have changed the tuning
+	else if (bHasPrecomputedVelocity && PrecomputedInput.Matches(Input) && PrecomputedTuning.Matches(Tuning))
 	{
-		// If we're crouching or not sliding, just use max
-		MaxStepHeight = DefaultStepHeight;
-		SetWalkableFloorZ(DefaultWalkableFloorZ);
+		Output = PrecomputedOutput;
 	}
+	// walk move
 	else
 	{
-		// Scale step/ramp height down the faster we go
-		float Speed = FMath::Sqrt(SpeedSq);
-		float SpeedScale = (Speed - MinSlopeSpeedModifier) / (MaxSlopeSpeedModifier - MinSlopeSpeedModifier);
-		float SpeedMultiplier = FMath::Clamp(SpeedScale, 0.0f, 1.0f);
-		SpeedMultiplier *= SpeedMultiplier;
-		if (!IsFalling())
-		{
-			// If we're on ground, factor in friction.
-			SpeedMultiplier = FMath::Max((1.0f - SurfaceFriction) * SpeedMultiplier, 0.0f);
-		}
-		MaxStepHeight = FMath::Lerp(DefaultStepHeight, MinStepHeight, SpeedMultiplier);
-		SetWalkableFloorZ(FMath::Lerp(DefaultWalkableFloorZ, 0.9848f, SpeedMultiplier));
+		FAlphaVelocityKernel::Calculate(Tuning, Input, Output);
 	}
+
+	bHasPrecomputedVelocity = false;
+
+	Velocity = Output.Velocity;
+	Acceleration = Output.Acceleration;
+	MaxStepHeight = Output.MaxStepHeight;
+	SetWalkableFloorZ(Output.WalkableFloorZ);
 }
 
 bool UAlphaMovementConfig::CanAttemptJump() const
@@ -826,30 +2113,151 @@ bool UAlphaMovementConfig::CanAttemptJump() const
 
 float UAlphaMovementConfig::GetMaxSpeed() const
 {
+	// ducking only slows ground movement, air strafing keeps its speed
+	if (IsCrouching() && IsMovingOnGround())
+		return MaxWalkSpeedCrouched;
+
+	if (ActiveZone.bOverrideMaxSpeed)
+		return ActiveZone.MaxSpeed;
+
 	if (AlphaCharacter->IsWalking() || AlphaCharacter->DoesWantToWalk())
 		return WalkMovementSpeed;
 
 	return BaseMovementSpeed;
 }
 
+float UAlphaMovementConfig::GetGravityZ() const
+{
+	// the zone stands in for the physics volume, the character still scales it like the volume's gravity
+	if (ActiveZone.bOverrideGravityZ)
+		return ActiveZone.GravityZ * GravityScale;
+
+	return Super::GetGravityZ();
+}
+
+FAlphaVelocityTuning UAlphaMovementConfig::GetVelocityTuning() const
+{
+	FAlphaVelocityTuning Tuning;
+	Tuning.GroundAccelerationModifier = GroundAccelerationModifier;
+	Tuning.AirAccelerationModifier = ActiveZone.bOverrideAirAcceleration ? ActiveZone.AirAccelerationModifier : AirAccelerationModifier;
+	Tuning.AirSpeedCap = ActiveZone.bOverrideAirSpeedCap ? ActiveZone.AirSpeedCap : AirSpeedCap;
+	Tuning.AxisSpeedLimit = AxisSpeedLimit;
+	Tuning.BrakingFriction = BrakingFriction;
+	Tuning.BrakingFrictionFactor = BrakingFrictionFactor;
+	Tuning.BrakingSubStepTime = BrakingSubStepTime;
+	Tuning.MaxWalkSpeedCrouched = MaxWalkSpeedCrouched;
+	Tuning.MinSlopeSpeedModifier = MinSlopeSpeedModifier;
+	Tuning.MaxSlopeSpeedModifier = MaxSlopeSpeedModifier;
+	Tuning.DefaultStepHeight = DefaultStepHeight;
+	Tuning.MinStepHeight = MinStepHeight;
+	Tuning.DefaultWalkableFloorZ = DefaultWalkableFloorZ;
+	Tuning.SlidingWalkableFloorZ = SLIDING_WALKABLE_FLOOR_Z;
+	Tuning.bUseSeparateBrakingFriction = bUseSeparateBrakingFriction;
+	return Tuning;
+}
+
+bool UAlphaMovementConfig::GatherVelocityInput(float DeltaTime, FAlphaVelocityInput& OutInput) const
+{
+	if (!HasValidData() || IsAsyncPhysicsMovementActive() || bDeterministicMovement || bCheatFlying || bForceMaxAccel || HasAnimRootMotion() || UpdatedComponent->IsSimulatingPhysics())
+		return false;
+
+	if (!IsMovingOnGround() && !IsFalling())
+		return false;
 
+	// remote clients are moved by their server moves, which wait for the tick on the server
+	const FDeferredServerMove* ServerMove = nullptr;
 
+	if (!CharacterOwner->IsLocallyControlled())
+	{
+		if (CharacterOwner->GetLocalRole() != ROLE_Authority || DeferredServerMoves.Num() == 0)
+			return false;
 
+		ServerMove = &DeferredServerMoves[0];
+	}
 
+	const float MaxAccel = GetMaxAcceleration();
+	FVector InputAcceleration;
+	float MoveDeltaTime = DeltaTime;
 
+	// mirrors MoveAutonomous for server moves and ControlledCharacterMove otherwise, then PhysWalking and PhysFalling
+	// which both calculate without the z axis
+	if (ServerMove)
+	{
+		const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
 
+		if (ServerData == nullptr)
+			return false;
 
+		InputAcceleration = ConstrainInputAcceleration(ServerMove->MoveData.Acceleration).GetClampedToMaxSize(MaxAccel);
+		MoveDeltaTime = ServerData->GetServerMoveDeltaTime(ServerMove->MoveData.TimeStamp, CharacterOwner->GetActorTimeDilation());
+	}
+	else
+	{
+		InputAcceleration = ScaleInputAcceleration(ConstrainInputAcceleration(GetPendingInputVector()));
+	}
 
+	const float AnalogModifier = InputAcceleration.SizeSquared() > 0.0f && MaxAccel > SMALL_NUMBER ? FMath::Clamp(InputAcceleration.Size() / MaxAccel, 0.0f, 1.0f) : 0.0f;
 
+	OutInput.Velocity = FVector(Velocity.X, Velocity.Y, 0.0f);
+	OutInput.Acceleration = FVector(InputAcceleration.X, InputAcceleration.Y, 0.0f);
+	OutInput.DeltaTime = MoveDeltaTime;
+	OutInput.Friction = FMath::Max(0.0f, IsFalling() ? FallingLateralFriction : GroundFriction);
+	OutInput.BrakingDeceleration = GetMaxBrakingDeceleration();
+	OutInput.MaxSpeed = FMath::Max(GetMaxSpeed() * AnalogModifier, GetMinAnalogSpeed());
+	OutInput.SurfaceFriction = SurfaceFriction;
+	OutInput.bFluid = false;
+	OutInput.bGroundMove = IsMovingOnGround() && bBrakingFrameTolerated;
+	OutInput.bFalling = IsFalling();
 
+	return true;
+}
 
+void UAlphaMovementConfig::SetPrecomputedVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, const FAlphaVelocityOutput& Output)
+{
+	PrecomputedTuning = Tuning;
+	PrecomputedInput = Input;
+	PrecomputedOutput = Output;
+	bHasPrecomputedVelocity = true;
+}
 
+float UAlphaMovementConfig::GetSlidingWalkableFloorZ()
+{
+	return SLIDING_WALKABLE_FLOOR_Z;
+}
 
+FAlphaTrajectoryParams UAlphaMovementConfig::GetTrajectoryParams() const
+{
+	FAlphaTrajectoryParams Params = MakeTrajectoryParams(GetGravityZ(), GetMaxSpeed());
+	Params.AirAcceleration *= SurfaceFriction;
 
+	if (CharacterOwner)
+		CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleSize(Params.CapsuleRadius, Params.CapsuleHalfHeight);
 
+	return Params;
+}
 
+FAlphaTrajectoryParams UAlphaMovementConfig::MakeTrajectoryParams(float InGravityZ, float InMaxSpeed) const
+{
+	FAlphaTrajectoryParams Params;
+	Params.GravityZ = InGravityZ;
+	Params.AxisSpeedLimit = AxisSpeedLimit;
 
+	// the same zone overrides the air move uses, on the class default object there is no zone and these are the defaults
+	const FAlphaVelocityTuning Tuning = GetVelocityTuning();
+	Params.AirSpeedCap = Tuning.AirSpeedCap;
 
+	// mirrors the air branch of CalcVelocity, input acceleration is clamped to the max speed before being scaled
+	Params.AirAcceleration = FMath::Min(GetMaxAcceleration(), InMaxSpeed) * Tuning.AirAccelerationModifier;
 
+	return Params;
+}
 
+FAlphaLandingPrediction UAlphaMovementConfig::PredictLanding(TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime, const FVector& WishDirection) const
+{
+	FAlphaTrajectoryCandidate Candidate;
+	Candidate.Origin = UpdatedComponent ? UpdatedComponent->GetComponentLocation() : FVector::ZeroVector;
+	Candidate.Velocity = Velocity;
+	Candidate.WishDirection = WishDirection.GetSafeNormal2D();
 
+	return FAlphaTrajectory::PredictLanding(GetTrajectoryParams(), Candidate, Surfaces, MaxTime);
+}
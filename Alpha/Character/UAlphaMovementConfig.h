@@ -1,5 +1,19 @@
 #pragma once
 #include "GameFramework/CharacterMovementComponent.h"
+#include <atomic>
+#include "FAlphaTrajectory.h"
+#include "FAlphaAsyncMovement.h"
+#include "FAlphaFloorCache.h"
+#include "FAlphaMovementCapture.h"
+#include "FAlphaMovementCounters.h"
+#include "FAlphaMovementSnapshot.h"
+#include "FAlphaProxySmoother.h"
+#include "FAlphaVelocityKernel.h"
+#include "UAlphaMovementBudgetSubsystem.h"
+#include "UAlphaMovementEventSubsystem.h"
+#include "Alpha/Network/UAlphaMoveValidationSubsystem.h"
+#include "Alpha/Replay/FAlphaDemo.h"
+#include "Alpha/World/AAlphaMovementZone.h"
 #include "UAlphaMovementConfig.generated.h"
 
 UCLASS()
@@ -13,9 +27,12 @@ public:
 	// init
 	virtual void InitializeComponent() override;
 	virtual void OnRegister() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// movement overrides
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void AsyncPhysicsTickComponent(float DeltaTime, float SimTime) override;
+	virtual void PerformMovement(float DeltaTime) override;
 	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
 	virtual void ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration) override;
 	virtual void PhysFalling(float deltaTime, int32 Iterations) override;
@@ -30,6 +47,10 @@ public:
 	// jump overrides
 	virtual bool CanAttemptJump() const override;
 	virtual bool DoJump(bool bReplayingMoves) override;
+
+	// crouch overrides
+	virtual void Crouch(bool bClientSimulation = false) override;
+	virtual void UnCrouch(bool bClientSimulation = false) override;
 	
 	virtual void TwoWallAdjust(FVector& Delta, const FHitResult& Hit, const FVector& OldHitNormal) const override;
 	virtual float SlideAlongSurface(const FVector& Delta, float Time, const FVector& Normal, FHitResult& Hit, bool bHandleImpact) override;
@@ -40,11 +61,155 @@ public:
 	virtual bool IsValidLandingSpot(const FVector& CapsuleLocation, const FHitResult& Hit) const override;
 	virtual bool ShouldCheckForValidLandingSpot(float DeltaTime, const FVector& Delta, const FHitResult& Hit) const override;
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
+	virtual void OnTeleported() override;
+	virtual void ProcessLanded(const FHitResult& Hit, float remainingTime, int32 Iterations) override;
+	virtual void ComputeFloorDist(const FVector& CapsuleLocation, float LineDistance, float SweepDistance, FFindFloorResult& OutFloorResult, float SweepRadius, const FHitResult* DownwardSweepResult = NULL) const override;
+
+	// network overrides
+	virtual void ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData) override;
+	virtual void ServerMovePacked_ServerReceive(const FCharacterServerMovePackedBits& PackedBits) override;
+	virtual bool ServerCheckClientError(float ClientTimeStamp, float DeltaTime, const FVector& Accel, const FVector& ClientWorldLocation, const FVector& RelativeClientLocation, UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
+	virtual bool ClientUpdatePositionAfterServerUpdate() override;
+	virtual void OnClientCorrectionReceived(FNetworkPredictionData_Client_Character& ClientData, float TimeStamp, FVector NewLocation, FVector NewVelocity, UPrimitiveComponent* NewBase, FName NewBaseBoneName, bool bHasBase, bool bBaseRelativePosition, uint8 ServerMovementMode) override;
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+	virtual void SmoothCorrection(const FVector& OldLocation, const FQuat& OldRotation, const FVector& NewLocation, const FQuat& NewRotation) override;
 	
 	void TraceCharacterFloor(FHitResult& OutHit);
 
 	float GetCameraRoll();
 	virtual float GetMaxSpeed() const override;
+	virtual float GetGravityZ() const override;
+
+	/**
+	 * Overrides of the AAlphaMovementZone the character was in at the start of its last update
+	 */
+	const FAlphaMovementZoneSettings& GetActiveZoneSettings() const
+	{
+		return ActiveZone;
+	}
+
+	/**
+	 * Fidelity the movement budget let the last update run at
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Character Movement: Budget")
+	EAlphaMovementTier GetMovementTier() const
+	{
+		return MovementTier;
+	}
+
+	/**
+	 * Whether the movement budget throttles how often the character replicates, which also applies to players
+	 */
+	bool IsProxyRateReduced() const
+	{
+		return bProxyRateReduced;
+	}
+
+	/**
+	 * Returns the tuning needed to solve falling arcs for this character with FAlphaTrajectory
+	 */
+	FAlphaTrajectoryParams GetTrajectoryParams() const;
+
+	/**
+	 * Returns the trajectory tuning for an explicit gravity and max speed, safe to call on the class default object
+	 */
+	FAlphaTrajectoryParams MakeTrajectoryParams(float InGravityZ, float InMaxSpeed) const;
+
+	/**
+	 * Predicts where the character lands from its current state without stepping the simulation
+	 * @param Surfaces Coarse collision to land on
+	 * @param MaxTime Max time (in seconds) to look ahead
+	 * @param WishDirection Direction the character is expected to strafe towards, zero for no input
+	 */
+	FAlphaLandingPrediction PredictLanding(TArrayView<const FAlphaLandingSurface> Surfaces, float MaxTime, const FVector& WishDirection = FVector::ZeroVector) const;
+	
+	/**
+	 * Starts recording movement to a demo file, see FAlphaDemoWriter
+	 */
+	bool StartDemoRecording(const FString& Filename);
+	void StopDemoRecording();
+
+	bool IsRecordingDemo() const
+	{
+		return DemoWriter.IsValid();
+	}
+	
+	/**
+	 * Returns the tuning read by FAlphaVelocityKernel
+	 */
+	FAlphaVelocityTuning GetVelocityTuning() const;
+
+	/**
+	 * Predicts the input CalcVelocity will see during the next movement tick, for the parallel velocity phase. For a
+	 * remote player on the server that is the first move deferred to the tick, see ServerMove_PerformMovement
+	 * @return False if the next update can't be predicted (simulated proxies, root motion, noclip, ...)
+	 */
+	bool GatherVelocityInput(float DeltaTime, FAlphaVelocityInput& OutInput) const;
+
+	/**
+	 * Stores a result from the parallel velocity phase, CalcVelocity uses it if its input and tuning still match
+	 */
+	void SetPrecomputedVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, const FAlphaVelocityOutput& Output);
+	
+	/**
+	 * True if velocity is stepped on the async physics tick, see bUseAsyncPhysicsMovement
+	 */
+	bool IsAsyncPhysicsMovementActive() const
+	{
+		return bAsyncPhysicsMovementActive.load(std::memory_order_relaxed);
+	}
+	
+	/**
+	 * Captures the state needed to resimulate from this tick, see bDeterministicMovement
+	 */
+	FAlphaMovementSnapshot CaptureSnapshot() const;
+
+	/**
+	 * Rewinds to a captured state without firing movement events
+	 */
+	void RestoreSnapshot(const FAlphaMovementSnapshot& Snapshot);
+
+	/**
+	 * Puts the component back into the state and input a captured tick started from, the next tick replays it
+	 */
+	void ApplyCapture(const FAlphaMovementCapture& Capture);
+
+	/**
+	 * Starting floor and sweeps of the last tick replayed through ApplyCapture, in the layout of the capture
+	 */
+	const FAlphaMovementCapture& GetReplayedTick() const
+	{
+		return TickCapture;
+	}
+
+	/**
+	 * Clears everything left over from a previous life when a pooled character respawns, see UAlphaCharacterPoolSubsystem
+	 */
+	void ResetForRespawn();
+
+	/**
+	 * Runs one fixed deterministic step with the given input, used to resimulate after restoring a snapshot
+	 */
+	void SimulateDeterministicStep(const FVector& InputVector, bool bJump);
+
+	uint32 GetDeterministicTick() const
+	{
+		return DeterministicTick;
+	}
+	
+	/**
+	 * Cost of the last replay of saved moves after a server correction
+	 */
+	const FAlphaMovementCounters& GetLastReplayCost() const
+	{
+		return LastReplayCost;
+	}
+
+	/**
+	 * Called by UAlphaMoveValidationSubsystem when a client claimed more ground than its allowed speed covers,
+	 * clamps the velocity and corrects the client on its next move
+	 */
+	void CorrectInvalidMove(float AllowedSpeed);
 	
 	FORCEINLINE FVector GetAcceleration() const
 	{
@@ -55,9 +220,61 @@ public:
 	{
 		return bBrakingFrameTolerated;
 	}
+
+	/**
+	 * Returns the walkable floor z used when moving slowly, steeper surfaces are surfed
+	 */
+	float GetDefaultWalkableFloorZ() const
+	{
+		return DefaultWalkableFloorZ;
+	}
+
+	/**
+	 * Returns the step height used when moving slowly
+	 */
+	float GetDefaultStepHeight() const
+	{
+		return DefaultStepHeight;
+	}
+
+	/**
+	 * Returns the step height used when sliding at max slope speed
+	 */
+	float GetMinStepHeight() const
+	{
+		return MinStepHeight;
+	}
+
+	/**
+	 * Returns the walkable floor z used when sliding at max slope speed
+	 */
+	static float GetSlidingWalkableFloorZ();
 	
 protected:
+	virtual bool MoveUpdatedComponentImpl(const FVector& Delta, const FQuat& NewRotation, bool bSweep, FHitResult* OutHit = NULL, ETeleportType Teleport = ETeleportType::None) override;
+	virtual void SmoothClientPosition(float DeltaSeconds) override;
+
+	/**
+	 * Publishes an event to the world's UAlphaMovementEventSubsystem, skipped while replaying moves
+	 */
+	void PublishMovementEvent(EAlphaMovementEventType Type, const FHitResult& Hit, float Friction, EMovementMode PreviousMode);
+
 	class AAlphaBaseCharacter* AlphaCharacter;
+
+	UPROPERTY(Transient)
+	UAlphaMovementEventSubsystem* MovementEvents;
+
+	UPROPERTY(Transient)
+	class UAlphaMovementBatchSubsystem* MovementBatch;
+
+	UPROPERTY(Transient)
+	class UAlphaMoveValidationSubsystem* MoveValidation;
+
+	UPROPERTY(Transient)
+	class UAlphaMovementZoneSubsystem* MovementZones;
+
+	UPROPERTY(Transient)
+	UAlphaMovementBudgetSubsystem* MovementBudget;
 	
 	/**
 	 * Multiplier for acceleration when on the ground
@@ -137,6 +354,63 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Walking")
 	float SlideLimit = 0.5f;
 	
+	/**
+	 * Steps velocity at the fixed async physics rate instead of once per frame, collision still moves on the game
+	 * thread. Needs Tick Physics Async in the physics settings. Characters driven on this machine step on the async
+	 * physics tick, moves received from or replayed for a client are split into steps of the same length
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Async Physics")
+	bool bUseAsyncPhysicsMovement = false;
+
+	/**
+	 * Moves in fixed steps with quantized state and a random stream seeded from the tick, so the same inputs from
+	 * the same snapshot always produce the same state. The component still ticks and sends one move per frame, each
+	 * move runs the steps it covers and a frame without a step keeps its input for the next one
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Deterministic")
+	bool bDeterministicMovement = false;
+
+	/**
+	 * Length of a deterministic step in seconds
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Deterministic", meta = (EditCondition = "bDeterministicMovement"))
+	float DeterministicTimeStep = 1.0f / 128.0f;
+
+	/**
+	 * Max steps per move, time beyond it is dropped so a hitch can't spiral
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Deterministic", meta = (EditCondition = "bDeterministicMovement"))
+	int32 MaxDeterministicSteps = 8;
+
+	/**
+	 * Mixed into the random stream seed, must be the same for this character on every machine
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Deterministic", meta = (EditCondition = "bDeterministicMovement"))
+	int32 DeterministicSeed = 0;
+
+	/**
+	 * Resolves falling collisions by clipping the velocity against every plane hit during the step at once, like
+	 * Quake's slide move, instead of sliding and adjusting against two walls one hit at a time
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Character Movement: Jumping / Falling")
+	bool bUseMultiPlaneClipping = true;
+
+	/**
+	 * Smooths simulated proxies along Hermite curves through the last replicated states instead of the network
+	 * smoothing mode, see FAlphaProxySmoother
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Network Smoothing")
+	bool bUseHermiteProxySmoothing = true;
+
+	/**
+	 * Bounds (in seconds) of the render delay, it adapts to the update interval and jitter in between
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Network Smoothing", meta = (EditCondition = "bUseHermiteProxySmoothing", ClampMin = "0", UIMin = "0"))
+	float MinProxySmoothingDelay = 0.05f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Character Movement: Network Smoothing", meta = (EditCondition = "bUseHermiteProxySmoothing", ClampMin = "0", UIMin = "0"))
+	float MaxProxySmoothingDelay = 0.25f;
+	
 	/**
 	 * FLAG
 	 * If the player has been on the ground for at least one frame and braking can be applied
@@ -147,4 +421,195 @@ private:
 	float DefaultStepHeight;
 	float DefaultWalkableFloorZ;
 	float SurfaceFriction;
+
+	FAlphaVelocityTuning PrecomputedTuning;
+	FAlphaVelocityInput PrecomputedInput;
+	FAlphaVelocityOutput PrecomputedOutput;
+	bool bHasPrecomputedVelocity;
+
+	/**
+	 * Hands state to the async physics tick and back
+	 */
+	void PushAsyncMovementState();
+	void ConsumeAsyncVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output);
+
+	/**
+	 * Steps a whole move at the async physics rate on the game thread, for moves that didn't run on this machine's
+	 * physics tick (client moves on the server and replayed saved moves)
+	 */
+	void SubstepAsyncVelocity(const FAlphaVelocityTuning& Tuning, const FAlphaVelocityInput& Input, FAlphaVelocityOutput& Output) const;
+
+	/**
+	 * True if this update's velocity comes from the async physics tick rather than being stepped on the game thread
+	 */
+	bool ShouldUseAsyncPhysicsSteps() const;
+
+	/**
+	 * Number of fixed steps a move of DeltaTime covers, sets the tick of the first one
+	 */
+	int32 GetDeterministicSteps(float DeltaTime, float TimeStep);
+
+	/**
+	 * Client timestamp of the move being performed, false for moves that aren't sent to or received from a server
+	 */
+	bool GetDeterministicMoveTimeStamp(float& OutTimeStamp) const;
+	void BeginDeterministicStep();
+	void EndDeterministicStep();
+
+	/**
+	 * True if floor queries go through the floor cache, autonomous proxies only
+	 */
+	bool ShouldUseFloorCache() const;
+
+	/**
+	 * Query params for TraceCharacterFloor, built once instead of every trace since the ignored actor list allocates.
+	 * Rebuilt on register and respawn, move ignore actors added in between aren't picked up
+	 */
+	void InitFloorQueryParams();
+	FCollisionQueryParams FloorQueryParams;
+	FCollisionResponseParams FloorResponseParams;
+	bool bFloorQueryParamsValid;
+
+	/**
+	 * Floor queries from the original simulation, reused when replaying saved moves
+	 */
+	mutable FAlphaFloorCache FloorCache;
+	FAlphaMovementCounters LastReplayCost;
+
+	/**
+	 * Client moves received before the velocity phase, simulated in order at the start of the movement tick so the
+	 * first one's velocity can be computed with everyone else's. The move data is copied as the stock
+	 * FCharacterNetworkMoveData, so moves are only deferred while the default move data container is in use.
+	 */
+	struct FDeferredServerMove
+	{
+		FCharacterNetworkMoveData MoveData;
+		TWeakObjectPtr<UPrimitiveComponent> MovementBase;
+		bool bIgnoreRootMotion;
+	};
+
+	/**
+	 * Container set up by the engine's constructor, SetNetworkMoveDataContainer replaces it with custom move data
+	 */
+	const FCharacterNetworkMoveDataContainer* DefaultMoveDataContainer;
+
+	bool ShouldDeferServerMoves() const;
+
+	/**
+	 * True on the server for a remote player, which only moves through PerformServerMove
+	 */
+	bool IsMovedByServerMoves() const;
+	void PerformServerMove(const FCharacterNetworkMoveData& MoveData);
+	void FlushDeferredServerMoves();
+	TArray<FDeferredServerMove> DeferredServerMoves;
+
+	/**
+	 * Moves simulated for a client since its last claimed location, handed to the validation subsystem with the
+	 * distance to the next one
+	 */
+	void FlushMoveValidation(float ClaimedDistance);
+	FAlphaMoveValidationSample PendingValidation;
+	FVector ClaimedLocation;
+	bool bHasClaimedLocation;
+	bool bForceMoveCorrection;
+
+	/**
+	 * Height of the static ceiling over the last blocked uncrouch and where it was measured, reused until the
+	 * character moves a capsule radius away from there
+	 */
+	void MeasureUncrouchClearance(const FVector& Location, float StandingTop);
+	FVector UncrouchClearanceLocation;
+	float UncrouchCeilingZ;
+	bool bHasUncrouchClearance;
+
+	/**
+	 * Continues a falling step after a blocking hit with the multi-plane clip solver
+	 * @return True if the step ended, by landing or leaving the falling mode
+	 */
+	bool ClipFallingMove(FHitResult& Hit, const FVector& OldLocation, const FQuat& PawnRotation, float Tick, float TimeRemaining, float& RemainingTime, int32 Iterations);
+
+	/**
+	 * Random hop off an edge the character is balanced on without moving, the perch handling of PhysFalling
+	 */
+	void NudgeOffPerch(const FVector& OldLocation, const FVector& PerchNormal, const FQuat& PawnRotation, float Tick, FHitResult& Hit);
+
+	/**
+	 * Normal a hit clips velocity against, flattened like HandleSlopeBoosting
+	 */
+	FVector GetClipNormal(const FHitResult& Hit) const;
+
+	/**
+	 * Slow tick watchdog, the tick's starting state is recorded while alpha.Movement.SlowTickMs is set and written
+	 * out if the tick went over it. Server moves of remote players are captured the same way.
+	 */
+	bool ShouldCaptureSlowTicks() const;
+	void BeginTickCapture(float DeltaTime);
+	void FinishTickCapture(uint64 TickCycles);
+	void EndTickCapture(float TickMs);
+	FAlphaMovementCapture TickCapture;
+	bool bCapturingTick;
+	bool bReplayingCapture;
+
+	/**
+	 * Asks the movement budget for this update's tier and applies it
+	 */
+	void UpdateMovementTier();
+	EAlphaMovementTier MovementTier;
+	bool bProxyRateReduced;
+	bool bDefaultAlwaysCheckFloor;
+
+	/**
+	 * Floor component surface friction was last traced on, reused while on it at reduced tiers
+	 */
+	TWeakObjectPtr<const UPrimitiveComponent> FrictionFloor;
+
+	/**
+	 * Looks up the movement zone at the current location, once per update
+	 */
+	void UpdateMovementZone();
+	FAlphaMovementZoneSettings ActiveZone;
+
+	bool ShouldUseHermiteSmoothing() const;
+	FAlphaProxySmoother ProxySmoother;
+
+	/**
+	 * Server stamp and arrival time of the last proxy state, to catch a stamp that stopped advancing
+	 */
+	float LastProxyServerTime;
+	float LastProxyLocalTime;
+	bool bWarnedStaleProxyTime;
+
+	uint32 DeterministicTick;
+	float DeterministicTimeAccumulator;
+
+	/**
+	 * Acceleration of the latest frame too short for a deterministic step, used by the next step if its own frame
+	 * has no input
+	 */
+	FVector PendingStepAcceleration;
+	float DeterministicMoveTimeStamp;
+	bool bHasDeterministicMoveTimeStamp;
+	bool bResimulating;
+
+	FAlphaAsyncMovementBuffer AsyncMovement;
+	TArray<FAlphaAsyncMovementStep> AsyncSteps;
+	uint32 AsyncSequence;
+
+	/**
+	 * Written by the game thread, read by the async physics tick
+	 */
+	std::atomic<bool> bAsyncPhysicsMovementActive;
+
+	// only touched by the async physics tick
+	FAlphaAsyncMovementInput AsyncInput;
+	FVector AsyncVelocity;
+	bool bHasAsyncInput;
+
+	/**
+	 * Controller the velocity phase was last made to wait for
+	 */
+	TWeakObjectPtr<class AController> BatchInputController;
+
+	TUniquePtr<FAlphaDemoWriter> DemoWriter;
+	float DemoTime;
 };
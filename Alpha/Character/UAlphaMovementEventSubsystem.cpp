@@ -0,0 +1,75 @@
+#include "UAlphaMovementEventSubsystem.h"
+#include "Alpha/Alpha.h"
+
+DECLARE_CYCLE_STAT(TEXT("Movement Event Delivery"), STAT_AlphaMovementEventDelivery, STATGROUP_AlphaMovement);
+
+constexpr uint32 WRITE_BUFFER_BIT = 1u << 31;
+
+UAlphaMovementEventSubsystem::UAlphaMovementEventSubsystem()
+	: WriteState(0)
+	, Committed{ 0, 0 }
+	, NumDropped(0)
+{
+	Capacity = 4096;
+}
+
+void UAlphaMovementEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Capacity = FMath::Max(Capacity, 1);
+	Buffers[0].SetNum(Capacity);
+	Buffers[1].SetNum(Capacity);
+}
+
+bool UAlphaMovementEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlphaMovementEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlphaMovementEventSubsystem, STATGROUP_Tickables);
+}
+
+void UAlphaMovementEventSubsystem::Publish(const FAlphaMovementEvent& Event)
+{
+	const uint32 Slot = WriteState.fetch_add(1, std::memory_order_acq_rel);
+	const int32 BufferIndex = (Slot & WRITE_BUFFER_BIT) ? 1 : 0;
+	const uint32 Index = Slot & ~WRITE_BUFFER_BIT;
+
+	if (Index < static_cast<uint32>(Buffers[BufferIndex].Num()))
+		Buffers[BufferIndex][Index] = Event;
+	else
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+
+	Committed[BufferIndex].fetch_add(1, std::memory_order_release);
+}
+
+void UAlphaMovementEventSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_AlphaMovementEventDelivery);
+
+	// new events go to the other buffer from here on
+	const uint32 ReadState = WriteState.load(std::memory_order_relaxed);
+	const uint32 OldState = WriteState.exchange((ReadState & WRITE_BUFFER_BIT) ^ WRITE_BUFFER_BIT, std::memory_order_acq_rel);
+	const int32 BufferIndex = (OldState & WRITE_BUFFER_BIT) ? 1 : 0;
+	const uint32 Reserved = OldState & ~WRITE_BUFFER_BIT;
+
+	// publishers that reserved a slot before the swap may still be copying into it
+	while (Committed[BufferIndex].load(std::memory_order_acquire) < Reserved)
+		FPlatformProcess::YieldThread();
+
+	Committed[BufferIndex].store(0, std::memory_order_relaxed);
+
+	const int32 NumEvents = FMath::Min(static_cast<int32>(Reserved), Buffers[BufferIndex].Num());
+
+	if (NumEvents == 0)
+		return;
+
+	const TArrayView<const FAlphaMovementEvent> Events(Buffers[BufferIndex].GetData(), NumEvents);
+	OnMovementEvents.Broadcast(Events);
+
+	if (OnMovementEventsDynamic.IsBound())
+		OnMovementEventsDynamic.Broadcast(TArray<FAlphaMovementEvent>(Events));
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineTypes.h"
+#include <atomic>
+#include "UAlphaMovementEventSubsystem.generated.h"
+
+class AAlphaBaseCharacter;
+
+UENUM(BlueprintType)
+enum class EAlphaMovementEventType : uint8
+{
+	Landed,
+	Jumped,
+	CatchAir,
+	ModeChanged
+};
+
+/**
+ * Something a movement component decided during its update, with the state it already computed
+ */
+USTRUCT(BlueprintType)
+struct FAlphaMovementEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	EAlphaMovementEventType Type = EAlphaMovementEventType::ModeChanged;
+
+	/**
+	 * Weak since buffered events outlive the frame and aren't seen by garbage collection
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	TWeakObjectPtr<AAlphaBaseCharacter> Character;
+
+	/**
+	 * Floor or landing hit the event was decided from
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	FHitResult Hit;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	FVector Velocity = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	float SurfaceFriction = 1.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	TEnumAsByte<EMovementMode> PreviousMode = MOVE_None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement Events")
+	TEnumAsByte<EMovementMode> NewMode = MOVE_None;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FAlphaMovementEventBatch, TArrayView<const FAlphaMovementEvent>);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FAlphaMovementEventBatchDynamic, const TArray<FAlphaMovementEvent>&, Events);
+
+/**
+ * Collects movement events from every UAlphaMovementConfig in the world and delivers them once per frame.
+ *
+ * Publishing reserves a slot in a preallocated buffer with a single atomic add, so it never locks or allocates and
+ * is safe from parallel movement updates. Buffers are swapped at the end of the frame and the whole frame's events
+ * are broadcast in one batch.
+ */
+UCLASS(Config = Game)
+class UAlphaMovementEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UAlphaMovementEventSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void Publish(const FAlphaMovementEvent& Event);
+
+	/**
+	 * Number of events dropped because a frame overflowed the buffer
+	 */
+	int32 GetNumDroppedEvents() const
+	{
+		return NumDropped.load(std::memory_order_relaxed);
+	}
+
+	FAlphaMovementEventBatch OnMovementEvents;
+
+	UPROPERTY(BlueprintAssignable, Category = "Movement Events")
+	FAlphaMovementEventBatchDynamic OnMovementEventsDynamic;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/**
+	 * Max events per frame, later events are dropped. Set in DefaultGame.ini under
+	 * [/Script/Alpha.AlphaMovementEventSubsystem]
+	 */
+	UPROPERTY(Config)
+	int32 Capacity;
+
+private:
+	TArray<FAlphaMovementEvent> Buffers[2];
+
+	/**
+	 * Top bit is the buffer being written, the rest is the number of reserved slots
+	 */
+	std::atomic<uint32> WriteState;
+
+	/**
+	 * Slots fully written per buffer, delivery waits for it to catch up with the reserved count
+	 */
+	std::atomic<uint32> Committed[2];
+
+	std::atomic<int32> NumDropped;
+};
@@ -0,0 +1,154 @@
+#include "UAlphaMovementMetricsSubsystem.h"
+#include "AAlphaBaseCharacter.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static TAutoConsoleVariable<float> CVarMetricsInterval(
+	TEXT("alpha.Metrics.Interval"),
+	10.0f,
+	TEXT("Seconds between movement metrics written by dedicated servers to Saved/Metrics. 0 disables them"),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarMetricsMaxFiles(
+	TEXT("alpha.Metrics.MaxFiles"),
+	6,
+	TEXT("Number of past metrics intervals kept in Saved/Metrics/History"),
+	ECVF_Default);
+
+const TCHAR* const METRICS_NAME = TEXT("alpha_movement");
+
+static void AddMetric(FString& Output, const TCHAR* Name, const TCHAR* Type, const TCHAR* Help, double Value)
+{
+	Output += FString::Printf(TEXT("# HELP %s_%s %s\n# TYPE %s_%s %s\n%s_%s %f\n"), METRICS_NAME, Name, Help, METRICS_NAME, Name, Type, METRICS_NAME, Name, Value);
+}
+
+static void AddSpeedHistogram(FString& Output, const FAlphaMovementCounters& Counters)
+{
+	Output += FString::Printf(TEXT("# HELP %s_speed Speed (unit/s) of every movement update since the server started\n# TYPE %s_speed histogram\n"), METRICS_NAME, METRICS_NAME);
+
+	uint64 Count = 0;
+
+	for (int32 Bucket = 0; Bucket < FAlphaMovementCounters::NumSpeedBuckets; Bucket++)
+	{
+		Count += Counters.SpeedSamples[Bucket];
+
+		if (Bucket < FAlphaMovementCounters::NumSpeedBuckets - 1)
+			Output += FString::Printf(TEXT("%s_speed_bucket{le=\"%.0f\"} %llu\n"), METRICS_NAME, (Bucket + 1) * FAlphaMovementCounters::SpeedBucketSize, Count);
+		else
+			Output += FString::Printf(TEXT("%s_speed_bucket{le=\"+Inf\"} %llu\n"), METRICS_NAME, Count);
+	}
+
+	Output += FString::Printf(TEXT("%s_speed_sum %llu\n%s_speed_count %llu\n"), METRICS_NAME, Counters.SpeedSum.Load(), METRICS_NAME, Count);
+}
+
+// writes next to the destination first, so scrapers never read half a file
+static bool WriteMetricsFile(const FString& Output, const FString& Filename)
+{
+	const FString TempFilename = Filename + TEXT(".tmp");
+
+	if (!FFileHelper::SaveStringToFile(Output, *TempFilename))
+		return false;
+
+	return IFileManager::Get().Move(*Filename, *TempFilename, true);
+}
+
+bool UAlphaMovementMetricsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlphaMovementMetricsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlphaMovementMetricsSubsystem, STATGROUP_Tickables);
+}
+
+void UAlphaMovementMetricsSubsystem::Deinitialize()
+{
+	if (PublishTask.IsValid())
+	{
+		PublishTask.Wait();
+		PublishTask = UE::Tasks::FTask();
+	}
+
+	Super::Deinitialize();
+}
+
+void UAlphaMovementMetricsSubsystem::Tick(float DeltaTime)
+{
+	const float Interval = CVarMetricsInterval.GetValueOnGameThread();
+
+	if (Interval <= 0.0f || !IsRunningDedicatedServer())
+		return;
+
+	TimeSincePublish += DeltaTime;
+
+	// a slow disk delays the next interval rather than queueing writes
+	if (TimeSincePublish < Interval || (PublishTask.IsValid() && !PublishTask.IsCompleted()))
+		return;
+
+	int32 NumCharacters = 0;
+
+	for (TActorIterator<AAlphaBaseCharacter> It(GetWorld()); It; ++It)
+		NumCharacters++;
+
+	const uint64 NumFrames = GFrameCounter - LastFrame;
+	const float Seconds = TimeSincePublish;
+	const int32 MaxFiles = CVarMetricsMaxFiles.GetValueOnGameThread();
+
+	LastFrame = GFrameCounter;
+	TimeSincePublish = 0.0f;
+
+	PublishTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, NumCharacters, NumFrames, Seconds, MaxFiles]
+	{
+		Publish(NumCharacters, NumFrames, Seconds, MaxFiles);
+	});
+}
+
+void UAlphaMovementMetricsSubsystem::Publish(int32 NumCharacters, uint64 NumFrames, float Seconds, int32 MaxFiles)
+{
+	const FAlphaMovementCounters Counters = FAlphaMovementCounters::GetTotal();
+	const FAlphaMovementCounters Interval = Counters - LastCounters;
+	const bool bFirst = !bHasLastCounters;
+
+	LastCounters = Counters;
+	bHasLastCounters = true;
+
+	// the first interval includes everything before the subsystem started
+	if (bFirst || NumFrames == 0 || Seconds <= 0.0f)
+		return;
+
+	const double Frames = static_cast<double>(NumFrames);
+	const double CharacterFrames = Frames * FMath::Max(NumCharacters, 1);
+
+	FString Output;
+	AddMetric(Output, TEXT("characters"), TEXT("gauge"), TEXT("Characters in the world"), NumCharacters);
+	AddMetric(Output, TEXT("cpu_ms_per_frame"), TEXT("gauge"), TEXT("Movement time (in ms) per frame"), FPlatformTime::ToMilliseconds64(Interval.MovementCycles) / Frames);
+	AddMetric(Output, TEXT("updates_per_second"), TEXT("gauge"), TEXT("Movement updates per second"), Interval.MovementUpdates / Seconds);
+	AddMetric(Output, TEXT("sweeps_per_character"), TEXT("gauge"), TEXT("Move and floor sweeps per character per frame"), (Interval.MoveSweeps + Interval.FloorSweeps) / CharacterFrames);
+	AddMetric(Output, TEXT("corrections_per_second"), TEXT("gauge"), TEXT("Corrections sent to clients per second"), Interval.Corrections / Seconds);
+	AddMetric(Output, TEXT("saved_move_bytes_per_second"), TEXT("gauge"), TEXT("Bytes of packed client moves received per second"), Interval.ServerMoveBytes / Seconds);
+	AddMetric(Output, TEXT("degraded_updates_per_second"), TEXT("gauge"), TEXT("Updates run below full fidelity by the movement budget per second"), Interval.DegradedUpdates / Seconds);
+	AddMetric(Output, TEXT("landings_total"), TEXT("counter"), TEXT("Landings since the server started"), Counters.Landings);
+	AddMetric(Output, TEXT("catch_air_total"), TEXT("counter"), TEXT("Catch airs since the server started"), Counters.CatchAirs);
+	// histogram buckets are counters, scrapers take the rate themselves
+	AddSpeedHistogram(Output, Counters);
+
+	const FString Directory = FPaths::ProjectSavedDir() / TEXT("Metrics");
+	IFileManager::Get().MakeDirectory(*Directory, true);
+
+	if (!WriteMetricsFile(Output, Directory / FString::Printf(TEXT("%s.prom"), METRICS_NAME)))
+		UE_LOG(LogTemp, Warning, TEXT("UAlphaMovementMetricsSubsystem could not write to %s"), *Directory);
+
+	// a textfile collector reads every .prom file in the directory, the history can't sit next to the latest one
+	if (MaxFiles > 0)
+	{
+		const FString HistoryDirectory = Directory / TEXT("History");
+		IFileManager::Get().MakeDirectory(*HistoryDirectory, true);
+		WriteMetricsFile(Output, HistoryDirectory / FString::Printf(TEXT("%s.%u.prom"), METRICS_NAME, NumPublished % MaxFiles));
+	}
+
+	NumPublished++;
+}
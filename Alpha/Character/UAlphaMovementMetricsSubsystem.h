@@ -0,0 +1,38 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "FAlphaMovementCounters.h"
+#include "UAlphaMovementMetricsSubsystem.generated.h"
+
+/**
+ * Publishes aggregated movement metrics of a dedicated server in the Prometheus text format.
+ *
+ * Every alpha.Metrics.Interval seconds the per-thread movement counters are merged and written to
+ * Saved/Metrics/alpha_movement.prom, for a node exporter textfile collector or any other scraper. A rotating history
+ * of the last alpha.Metrics.MaxFiles intervals goes to Saved/Metrics/History, out of the directory the collector
+ * reads, where it would export the same series once per file. Merging and writing run on a background task, the
+ * game thread only counts characters and launches it.
+ */
+UCLASS()
+class UAlphaMovementMetricsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void Publish(int32 NumCharacters, uint64 NumFrames, float Seconds, int32 MaxFiles);
+
+	UE::Tasks::FTask PublishTask;
+	FAlphaMovementCounters LastCounters;
+	uint64 LastFrame = 0;
+	uint32 NumPublished = 0;
+	float TimeSincePublish = 0.0f;
+	bool bHasLastCounters = false;
+};
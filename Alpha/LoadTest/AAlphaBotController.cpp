@@ -0,0 +1,81 @@
+#include "AAlphaBotController.h"
+#include "GameFramework/Character.h"
+
+AAlphaBotController::AAlphaBotController()
+{
+	Pattern = EAlphaBotPattern::Run;
+	TurnRate = 0.0f;
+	TimeUntilChange = 0.0f;
+	MoveInput = FVector2D::ZeroVector;
+	bHoldJump = false;
+	bSetControlRotationFromPawnOrientation = false;
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AAlphaBotController::SetPattern(EAlphaBotPattern NewPattern, int32 Seed)
+{
+	Pattern = NewPattern;
+	RandomStream.Initialize(Seed);
+	TimeUntilChange = 0.0f;
+
+	// alternate strafe direction so bots don't all circle the same way
+	TurnRate = (RandomStream.FRand() < 0.5f ? -1.0f : 1.0f) * RandomStream.FRandRange(90.0f, 180.0f);
+}
+
+void AAlphaBotController::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ACharacter* Character = Cast<ACharacter>(GetPawn());
+
+	if (Character == nullptr)
+		return;
+
+	FRotator Rotation = GetControlRotation();
+	TimeUntilChange -= DeltaSeconds;
+
+	switch (Pattern)
+	{
+	case EAlphaBotPattern::Run:
+		MoveInput = FVector2D(0.0f, 1.0f);
+		bHoldJump = false;
+
+		if (TimeUntilChange <= 0.0f)
+		{
+			Rotation.Yaw += 180.0f;
+			TimeUntilChange = 4.0f;
+		}
+		break;
+
+	case EAlphaBotPattern::Bhop:
+		// turn into the strafe to gain speed in the air
+		Rotation.Yaw += TurnRate * DeltaSeconds;
+		MoveInput = FVector2D(FMath::Sign(TurnRate), 0.0f);
+		bHoldJump = true;
+		break;
+
+	case EAlphaBotPattern::Random:
+		if (TimeUntilChange <= 0.0f)
+		{
+			Rotation.Yaw = RandomStream.FRandRange(-180.0f, 180.0f);
+			MoveInput = FVector2D(RandomStream.FRandRange(-1.0f, 1.0f), RandomStream.FRandRange(-1.0f, 1.0f));
+			bHoldJump = RandomStream.FRand() < 0.3f;
+			TimeUntilChange = RandomStream.FRandRange(1.0f, 3.0f);
+		}
+		break;
+	}
+
+	SetControlRotation(Rotation);
+
+	const FRotator MoveRot(0.0f, Rotation.Yaw, 0.0f);
+
+	if (!FMath::IsNearlyZero(MoveInput.Y))
+		Character->AddMovementInput(MoveRot.RotateVector(FVector::ForwardVector), MoveInput.Y);
+
+	if (!FMath::IsNearlyZero(MoveInput.X))
+		Character->AddMovementInput(MoveRot.RotateVector(FVector::RightVector), MoveInput.X);
+
+	// held jump is pressed every frame, the same way the triggered input action does it
+	if (bHoldJump)
+		Character->Jump();
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "AIController.h"
+#include "AAlphaBotController.generated.h"
+
+/**
+ * Scripted input a load test bot plays back
+ */
+UENUM()
+enum class EAlphaBotPattern : uint8
+{
+	/** Runs back and forth along a line */
+	Run,
+
+	/** Strafe jumps in a circle, holding jump to bhop */
+	Bhop,
+
+	/** Picks a new direction, input and jump at random intervals */
+	Random
+};
+
+/**
+ * Drives an Alpha character with scripted input so the server simulates it like a player
+ */
+UCLASS()
+class AAlphaBotController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AAlphaBotController();
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	/**
+	 * Sets the input pattern, the seed makes every run of the same bot identical
+	 */
+	void SetPattern(EAlphaBotPattern NewPattern, int32 Seed);
+
+protected:
+	EAlphaBotPattern Pattern;
+	FRandomStream RandomStream;
+
+	/**
+	 * Yaw change (deg/s) while strafing
+	 */
+	float TurnRate;
+
+	/**
+	 * Time until the next direction change
+	 */
+	float TimeUntilChange;
+
+	/**
+	 * X is right/left, Y is forward/back
+	 */
+	FVector2D MoveInput;
+	bool bHoldJump;
+};
@@ -0,0 +1,486 @@
+#include "AAlphaLoadTestGameMode.h"
+#include "Alpha/Character/Impl/Generic/AAlphaGenericCharacter.h"
+#include "Alpha/Character/FAlphaMovementCapture.h"
+#include "Alpha/Character/UAlphaCharacterPoolSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerStart.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+
+static uint64 GetReplicationBytes(const UWorld* World)
+{
+	const UNetDriver* NetDriver = World->GetNetDriver();
+	return NetDriver ? NetDriver->OutTotalBytes : 0;
+}
+
+/**
+ * Summarizes samples as percentiles (in the sample unit)
+ */
+static TSharedRef<FJsonObject> MakePercentiles(TArray<float> Samples)
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+
+	if (Samples.Num() == 0)
+		return Object;
+
+	Samples.Sort();
+
+	double Sum = 0.0;
+	for (const float Sample : Samples)
+		Sum += Sample;
+
+	auto Percentile = [&Samples](float Fraction)
+	{
+		return Samples[FMath::Clamp(FMath::FloorToInt(Fraction * (Samples.Num() - 1)), 0, Samples.Num() - 1)];
+	};
+
+	Object->SetNumberField(TEXT("mean"), Sum / Samples.Num());
+	Object->SetNumberField(TEXT("p50"), Percentile(0.5f));
+	Object->SetNumberField(TEXT("p90"), Percentile(0.9f));
+	Object->SetNumberField(TEXT("p99"), Percentile(0.99f));
+	Object->SetNumberField(TEXT("max"), Samples.Last());
+
+	return Object;
+}
+
+// distance (in units) and normal or time difference a replayed query may be off by and still count as the captured one
+const float REPLAY_TOLERANCE = 0.01f;
+
+static bool IsSameFloor(const FAlphaMovementCapture& Captured, const FAlphaMovementCapture& Replayed)
+{
+	return Captured.bWalkableFloor == Replayed.bWalkableFloor
+		&& Captured.FloorNormal.Equals(Replayed.FloorNormal, REPLAY_TOLERANCE)
+		&& FMath::IsNearlyEqual(Captured.FloorDist, Replayed.FloorDist, REPLAY_TOLERANCE);
+}
+
+/**
+ * Index of the first replayed sweep which differs from the captured one, INDEX_NONE if they all match
+ */
+static int32 FindDivergentSweep(const FAlphaMovementCapture& Captured, const FAlphaMovementCapture& Replayed)
+{
+	const int32 NumSweeps = FMath::Min(Captured.Sweeps.Num(), Replayed.Sweeps.Num());
+
+	for (int32 Index = 0; Index < NumSweeps; Index++)
+	{
+		const FAlphaCapturedSweep& A = Captured.Sweeps[Index];
+		const FAlphaCapturedSweep& B = Replayed.Sweeps[Index];
+
+		if (A.bBlockingHit != B.bBlockingHit
+			|| !A.Start.Equals(B.Start, REPLAY_TOLERANCE)
+			|| !A.Delta.Equals(B.Delta, REPLAY_TOLERANCE)
+			|| !A.ImpactNormal.Equals(B.ImpactNormal, REPLAY_TOLERANCE)
+			|| !FMath::IsNearlyEqual(A.Time, B.Time, REPLAY_TOLERANCE))
+		{
+			return Index;
+		}
+	}
+
+	// one side stopped sweeping before the other
+	return Captured.Sweeps.Num() != Replayed.Sweeps.Num() ? NumSweeps : INDEX_NONE;
+}
+
+AAlphaLoadTestGameMode::AAlphaLoadTestGameMode()
+{
+	BotClass = AAlphaGenericCharacter::StaticClass();
+	NumBots = 32;
+	Pattern = EAlphaBotPattern::Bhop;
+	Seed = 1;
+	WarmupTime = 5.0f;
+	Duration = 30.0f;
+	BotSpacing = 300.0f;
+	bGenerateBenchmarkMap = false;
+	CaptureRepeats = 100;
+	bExitWhenDone = false;
+	StartReplicationBytes = 0;
+	EndReplicationBytes = 0;
+	SpeedSum = 0.0;
+	MaxSpeed = 0.0f;
+	NumSpeedSamples = 0;
+	ElapsedTime = 0.0f;
+	MeasuredTime = 0.0f;
+	bFinished = false;
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AAlphaLoadTestGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	Super::InitGame(MapName, Options, ErrorMessage);
+
+	auto ParseFloatOption = [&Options](const TCHAR* Key, float Default)
+	{
+		return UGameplayStatics::HasOption(Options, Key) ? FCString::Atof(*UGameplayStatics::ParseOption(Options, Key)) : Default;
+	};
+
+	NumBots = UGameplayStatics::GetIntOption(Options, TEXT("Bots"), NumBots);
+	Seed = UGameplayStatics::GetIntOption(Options, TEXT("Seed"), Seed);
+	WarmupTime = ParseFloatOption(TEXT("Warmup"), WarmupTime);
+	Duration = ParseFloatOption(TEXT("Duration"), Duration);
+	bExitWhenDone |= UGameplayStatics::HasOption(Options, TEXT("Exit"));
+	ReportPath = UGameplayStatics::ParseOption(Options, TEXT("Report"));
+	CapturePath = UGameplayStatics::HasOption(Options, TEXT("ReplayCapture")) ? UGameplayStatics::ParseOption(Options, TEXT("ReplayCapture")) : CapturePath;
+	CaptureRepeats = UGameplayStatics::GetIntOption(Options, TEXT("ReplayRepeat"), CaptureRepeats);
+
+	if (UGameplayStatics::HasOption(Options, TEXT("BenchmarkSeed")))
+	{
+		bGenerateBenchmarkMap = true;
+		BenchmarkMapParams.Seed = UGameplayStatics::GetIntOption(Options, TEXT("BenchmarkSeed"), BenchmarkMapParams.Seed);
+	}
+
+	const FString PatternName = UGameplayStatics::ParseOption(Options, TEXT("Pattern"));
+
+	if (!PatternName.IsEmpty())
+	{
+		const int64 PatternValue = StaticEnum<EAlphaBotPattern>()->GetValueByNameString(PatternName);
+
+		if (PatternValue != INDEX_NONE)
+			Pattern = static_cast<EAlphaBotPattern>(PatternValue);
+		else
+			UE_LOG(LogTemp, Error, TEXT("AAlphaLoadTestGameMode unknown pattern %s"), *PatternName);
+	}
+}
+
+void AAlphaLoadTestGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	if (bGenerateBenchmarkMap)
+		FAlphaBenchmarkMapGenerator::Generate(GetWorld(), BenchmarkMapParams);
+
+	// the capture is replayed on the first tick, once the world has begun play
+	if (!CapturePath.IsEmpty())
+		return;
+
+	SpawnBots();
+	LastCounters = FAlphaMovementCounters::GetTotal();
+
+	UE_LOG(LogTemp, Display, TEXT("AAlphaLoadTestGameMode spawned %d bots, measuring for %.1fs after %.1fs warmup"), NumBots, Duration, WarmupTime);
+}
+
+void AAlphaLoadTestGameMode::SpawnBots()
+{
+	UWorld* World = GetWorld();
+	UAlphaCharacterPoolSubsystem* CharacterPool = World->GetSubsystem<UAlphaCharacterPoolSubsystem>();
+	FVector Origin = FVector::ZeroVector;
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		Origin = It->GetActorLocation();
+		break;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumBots))));
+
+	for (int32 Index = 0; Index < NumBots; Index++)
+	{
+		const FVector Offset((Index % Columns - Columns / 2) * BotSpacing, (Index / Columns - Columns / 2) * BotSpacing, 0.0f);
+		AAlphaBaseCharacter* Bot = CharacterPool ? CharacterPool->Acquire(BotClass, FTransform(Origin + Offset)) : World->SpawnActor<AAlphaBaseCharacter>(BotClass, Origin + Offset, FRotator::ZeroRotator, SpawnParams);
+
+		if (Bot == nullptr)
+			continue;
+
+		AAlphaBotController* BotController = World->SpawnActor<AAlphaBotController>(SpawnParams);
+
+		if (BotController == nullptr)
+		{
+			UE_LOG(LogTemp, Error, TEXT("AAlphaLoadTestGameMode failed to spawn a controller for bot %d"), Index);
+
+			if (CharacterPool)
+				CharacterPool->Release(Bot);
+			else
+				Bot->Destroy();
+
+			continue;
+		}
+
+		BotController->Possess(Bot);
+		BotController->SetPattern(Pattern, Seed + Index);
+	}
+}
+
+void AAlphaLoadTestGameMode::RestartPlayer(AController* NewPlayer)
+{
+	UAlphaCharacterPoolSubsystem* CharacterPool = GetWorld()->GetSubsystem<UAlphaCharacterPoolSubsystem>();
+
+	// the old character goes back to the pool, SpawnDefaultPawnAtTransform takes the new one out of it
+	if (CharacterPool && NewPlayer)
+	{
+		if (AAlphaBaseCharacter* Current = Cast<AAlphaBaseCharacter>(NewPlayer->GetPawn()))
+			CharacterPool->Release(Current);
+	}
+
+	Super::RestartPlayer(NewPlayer);
+}
+
+APawn* AAlphaLoadTestGameMode::SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform)
+{
+	UAlphaCharacterPoolSubsystem* CharacterPool = GetWorld()->GetSubsystem<UAlphaCharacterPoolSubsystem>();
+	UClass* PawnClass = GetDefaultPawnClassForController(NewPlayer);
+
+	if (CharacterPool && PawnClass && PawnClass->IsChildOf<AAlphaBaseCharacter>())
+		return CharacterPool->Acquire(PawnClass, SpawnTransform);
+
+	return Super::SpawnDefaultPawnAtTransform_Implementation(NewPlayer, SpawnTransform);
+}
+
+void AAlphaLoadTestGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (bFinished)
+		return;
+
+	if (!CapturePath.IsEmpty())
+	{
+		ReplayCapture();
+		bFinished = true;
+
+		if (bExitWhenDone)
+			FPlatformMisc::RequestExit(false);
+
+		return;
+	}
+
+	ElapsedTime += DeltaSeconds;
+
+	const FAlphaMovementCounters Counters = FAlphaMovementCounters::GetTotal();
+	const FAlphaMovementCounters FrameCounters = Counters - LastCounters;
+	LastCounters = Counters;
+
+	if (ElapsedTime < WarmupTime)
+	{
+		StartCounters = Counters;
+		StartReplicationBytes = GetReplicationBytes(GetWorld());
+		return;
+	}
+
+	MeasuredTime += DeltaSeconds;
+
+	// time the game thread spent working, without waiting for the server tick rate
+	FrameTimes.Add(static_cast<float>((FApp::GetDeltaTime() - FApp::GetIdleTime()) * 1000.0));
+	MovementTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(FrameCounters.MovementCycles)));
+
+	for (TActorIterator<AAlphaBaseCharacter> It(GetWorld()); It; ++It)
+	{
+		const float Speed = It->GetVelocity().Size();
+		SpeedSum += Speed;
+		MaxSpeed = FMath::Max(MaxSpeed, Speed);
+		NumSpeedSamples++;
+	}
+
+	if (MeasuredTime < Duration)
+		return;
+
+	bFinished = true;
+	EndCounters = Counters;
+	EndReplicationBytes = GetReplicationBytes(GetWorld());
+
+	WriteReport();
+
+	if (bExitWhenDone)
+		FPlatformMisc::RequestExit(false);
+}
+
+void AAlphaLoadTestGameMode::WriteReport() const
+{
+	const FAlphaMovementCounters Counters = EndCounters - StartCounters;
+	const uint64 ReplicationBytes = EndReplicationBytes - StartReplicationBytes;
+	const float Seconds = FMath::Max(MeasuredTime, KINDA_SMALL_NUMBER);
+	const int32 NumFrames = FMath::Max(FrameTimes.Num(), 1);
+
+	double FrameTotal = 0.0;
+	double MovementTotal = 0.0;
+	int32 NumClients = 0;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (It->IsValid() && !(*It)->IsLocalController())
+			NumClients++;
+	}
+
+	for (int32 Index = 0; Index < FrameTimes.Num(); Index++)
+	{
+		FrameTotal += FrameTimes[Index];
+		MovementTotal += MovementTimes[Index];
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("map"), GetWorld()->GetMapName());
+	Root->SetNumberField(TEXT("bots"), NumBots);
+	Root->SetStringField(TEXT("pattern"), StaticEnum<EAlphaBotPattern>()->GetNameStringByValue(static_cast<int64>(Pattern)));
+	Root->SetNumberField(TEXT("seed"), Seed);
+	Root->SetNumberField(TEXT("duration_s"), MeasuredTime);
+	Root->SetNumberField(TEXT("frames"), FrameTimes.Num());
+	Root->SetObjectField(TEXT("frame_ms"), MakePercentiles(FrameTimes));
+	Root->SetObjectField(TEXT("movement_ms"), MakePercentiles(MovementTimes));
+	Root->SetNumberField(TEXT("movement_cpu_share"), FrameTotal > 0.0 ? MovementTotal / FrameTotal : 0.0);
+	Root->SetNumberField(TEXT("movement_updates"), Counters.MovementUpdates);
+	Root->SetNumberField(TEXT("move_sweeps"), Counters.MoveSweeps);
+	Root->SetNumberField(TEXT("floor_sweeps"), Counters.FloorSweeps);
+	Root->SetNumberField(TEXT("sweeps_per_frame"), static_cast<double>(Counters.MoveSweeps + Counters.FloorSweeps) / NumFrames);
+	Root->SetNumberField(TEXT("degraded_updates"), Counters.DegradedUpdates);
+	Root->SetNumberField(TEXT("falling_steps"), Counters.FallingSteps);
+	Root->SetNumberField(TEXT("falling_sweeps"), Counters.FallingSweeps);
+	Root->SetNumberField(TEXT("sweeps_per_falling_step"), Counters.FallingSteps > 0 ? static_cast<double>(Counters.FallingSweeps) / Counters.FallingSteps : 0.0);
+	Root->SetNumberField(TEXT("client_connections"), NumClients);
+
+	// bots are moved by the server itself, nothing is corrected or replicated unless clients are connected
+	if (NumClients > 0)
+	{
+		Root->SetNumberField(TEXT("replication_bytes"), ReplicationBytes);
+		Root->SetNumberField(TEXT("replication_bytes_per_s"), ReplicationBytes / Seconds);
+		Root->SetNumberField(TEXT("corrections"), Counters.Corrections);
+		Root->SetNumberField(TEXT("corrections_per_s"), Counters.Corrections / Seconds);
+	}
+	else
+	{
+		TArray<TSharedPtr<FJsonValue>> NotMeasured;
+		NotMeasured.Add(MakeShared<FJsonValueString>(TEXT("replication_bytes")));
+		NotMeasured.Add(MakeShared<FJsonValueString>(TEXT("corrections")));
+		Root->SetArrayField(TEXT("not_measured"), NotMeasured);
+	}
+
+	Root->SetNumberField(TEXT("mean_speed"), NumSpeedSamples > 0 ? SpeedSum / NumSpeedSamples : 0.0);
+	Root->SetNumberField(TEXT("max_speed"), MaxSpeed);
+
+	SaveReport(Root, FString::Printf(TEXT("LoadTest_%d_%s.json"), NumBots, *FDateTime::Now().ToString()));
+}
+
+void AAlphaLoadTestGameMode::ReplayCapture()
+{
+	FAlphaMovementCapture Capture;
+
+	if (!Capture.Load(CapturePath))
+		return;
+
+	UWorld* World = GetWorld();
+
+	if (Capture.MapName != World->GetMapName())
+		UE_LOG(LogTemp, Warning, TEXT("AAlphaLoadTestGameMode capture was taken on %s, replaying on %s"), *Capture.MapName, *World->GetMapName());
+
+	// the captured class if it still exists, its tuning is what the capture ran with
+	UClass* CharacterClass = LoadClass<AAlphaBaseCharacter>(nullptr, *Capture.CharacterClass);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	AAlphaBaseCharacter* Character = World->SpawnActor<AAlphaBaseCharacter>(CharacterClass ? CharacterClass : BotClass.Get(), Capture.Before.Location, Capture.Before.Rotation.Rotator(), SpawnParams);
+	UAlphaMovementConfig* Movement = Character ? Character->GetMovementPtr() : nullptr;
+
+	if (Movement == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AAlphaLoadTestGameMode failed to spawn a character to replay %s"), *CapturePath);
+		return;
+	}
+
+	AAlphaBotController* BotController = World->SpawnActor<AAlphaBotController>(SpawnParams);
+
+	if (BotController == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AAlphaLoadTestGameMode failed to spawn a controller to replay %s"), *CapturePath);
+		Character->Destroy();
+		return;
+	}
+
+	BotController->Possess(Character);
+
+	// the harness drives the tick, the bot controller only holds the control rotation
+	BotController->SetActorTickEnabled(false);
+	Movement->SetComponentTickEnabled(false);
+
+	const FAlphaVelocityTuning Tuning = Movement->GetVelocityTuning();
+
+	const bool bTuningChanged = Tuning.GroundAccelerationModifier != Capture.Tuning.GroundAccelerationModifier
+		|| Tuning.AirAccelerationModifier != Capture.Tuning.AirAccelerationModifier
+		|| Tuning.AirSpeedCap != Capture.Tuning.AirSpeedCap
+		|| Tuning.AxisSpeedLimit != Capture.Tuning.AxisSpeedLimit
+		|| Movement->GetGravityZ() != Capture.GravityZ;
+
+	if (bTuningChanged)
+		UE_LOG(LogTemp, Warning, TEXT("AAlphaLoadTestGameMode movement tuning changed since %s was captured"), *CapturePath);
+
+	TArray<float> ReplayTimes;
+	ReplayTimes.Reserve(CaptureRepeats);
+	uint64 ReplaySweeps = 0;
+	int32 NumMatched = 0;
+	int32 NumFloorDiverged = 0;
+	int32 NumSweepsDiverged = 0;
+	int32 FirstDivergentSweep = INDEX_NONE;
+	const uint32 CapturedHash = Capture.After.GetStateHash();
+
+	for (int32 Repeat = 0; Repeat < CaptureRepeats; Repeat++)
+	{
+		Movement->ApplyCapture(Capture);
+
+		const uint64 StartSweeps = FAlphaMovementCounters::Get().MoveSweeps;
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		Movement->TickComponent(Capture.DeltaTime, LEVELTICK_All, &Movement->PrimaryComponentTick);
+
+		ReplayTimes.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)));
+		ReplaySweeps += FAlphaMovementCounters::Get().MoveSweeps - StartSweeps;
+		NumMatched += Movement->CaptureSnapshot().GetStateHash() == CapturedHash;
+
+		// a replay that starts on another floor or sweeps elsewhere isn't timing the captured tick anymore
+		const FAlphaMovementCapture& Replayed = Movement->GetReplayedTick();
+		const int32 DivergentSweep = FindDivergentSweep(Capture, Replayed);
+
+		if (!IsSameFloor(Capture, Replayed))
+		{
+			if (NumFloorDiverged++ == 0)
+				UE_LOG(LogTemp, Warning, TEXT("AAlphaLoadTestGameMode replay of %s started on another floor: normal %s dist %.3f walkable %d, captured normal %s dist %.3f walkable %d"), *CapturePath, *Replayed.FloorNormal.ToString(), Replayed.FloorDist, Replayed.bWalkableFloor, *Capture.FloorNormal.ToString(), Capture.FloorDist, Capture.bWalkableFloor);
+		}
+
+		if (DivergentSweep != INDEX_NONE)
+		{
+			if (NumSweepsDiverged++ == 0)
+			{
+				FirstDivergentSweep = DivergentSweep;
+				UE_LOG(LogTemp, Warning, TEXT("AAlphaLoadTestGameMode replay of %s diverged at sweep %d of %d (captured %d)"), *CapturePath, DivergentSweep, Replayed.Sweeps.Num(), Capture.Sweeps.Num());
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("capture"), CapturePath);
+	Root->SetStringField(TEXT("map"), World->GetMapName());
+	Root->SetNumberField(TEXT("captured_ms"), Capture.TickMs);
+	Root->SetNumberField(TEXT("delta_time"), Capture.DeltaTime);
+	Root->SetNumberField(TEXT("repeats"), CaptureRepeats);
+	Root->SetObjectField(TEXT("replay_ms"), MakePercentiles(ReplayTimes));
+	Root->SetNumberField(TEXT("captured_sweeps"), Capture.Sweeps.Num());
+	Root->SetNumberField(TEXT("replay_sweeps_per_tick"), CaptureRepeats > 0 ? static_cast<double>(ReplaySweeps) / CaptureRepeats : 0.0);
+	Root->SetNumberField(TEXT("matched_final_state"), NumMatched);
+	Root->SetNumberField(TEXT("floor_diverged"), NumFloorDiverged);
+	Root->SetNumberField(TEXT("sweeps_diverged"), NumSweepsDiverged);
+
+	if (FirstDivergentSweep != INDEX_NONE)
+		Root->SetNumberField(TEXT("first_divergent_sweep"), FirstDivergentSweep);
+
+	SaveReport(Root, FString::Printf(TEXT("Replay_%s_%s.json"), *FPaths::GetBaseFilename(CapturePath), *FDateTime::Now().ToString()));
+}
+
+void AAlphaLoadTestGameMode::SaveReport(const TSharedRef<FJsonObject>& Root, const FString& DefaultName) const
+{
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	const FString Path = !ReportPath.IsEmpty()
+		? ReportPath
+		: FPaths::ProfilingDir() / TEXT("AlphaLoadTest") / DefaultName;
+
+	if (FFileHelper::SaveStringToFile(Output, *Path))
+		UE_LOG(LogTemp, Display, TEXT("AAlphaLoadTestGameMode report written to %s"), *Path);
+	else
+		UE_LOG(LogTemp, Error, TEXT("AAlphaLoadTestGameMode failed to write report to %s"), *Path);
+}
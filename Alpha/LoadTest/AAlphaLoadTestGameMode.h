@@ -0,0 +1,127 @@
+#pragma once
+#include "GameFramework/GameModeBase.h"
+#include "AAlphaBotController.h"
+#include "FAlphaBenchmarkMapGenerator.h"
+#include "Alpha/Character/FAlphaMovementCounters.h"
+#include "AAlphaLoadTestGameMode.generated.h"
+
+class AAlphaBaseCharacter;
+
+/**
+ * Spawns scripted bots on a (headless) dedicated server and writes a machine readable report of how the server scaled.
+ *
+ * Options are read from the travel URL, for example:
+ * AlphaServer TestMap?game=/Script/Alpha.AlphaLoadTestGameMode?Bots=128?Pattern=Bhop?Duration=60?Exit -nullrhi -log
+ * Add ?BenchmarkSeed=7 to an empty map to run on generated surf, bhop and stair geometry.
+ *
+ * Bots and restarted players come out of UAlphaCharacterPoolSubsystem, so respawns are measured the way the game
+ * runs them. Bots are simulated by the server like players, but without a client nothing is corrected or replicated. Connect
+ * extra headless clients to include replication and correction cost, without them those metrics are listed under
+ * not_measured in the report.
+ *
+ * ?ReplayCapture=<file> runs a tick written by the slow tick watchdog instead (?ReplayRepeat= times, no bots), and
+ * reports how long it takes now and whether it still starts on the captured floor, makes the captured sweeps and
+ * ends in the captured state.
+ */
+UCLASS()
+class AAlphaLoadTestGameMode : public AGameModeBase
+{
+	GENERATED_BODY()
+
+public:
+	AAlphaLoadTestGameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+	virtual void StartPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void RestartPlayer(AController* NewPlayer) override;
+	virtual APawn* SpawnDefaultPawnAtTransform_Implementation(AController* NewPlayer, const FTransform& SpawnTransform) override;
+
+protected:
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	TSubclassOf<AAlphaBaseCharacter> BotClass;
+
+	/**
+	 * Number of bots to spawn (?Bots=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	int32 NumBots;
+
+	/**
+	 * Input pattern every bot plays (?Pattern=Run|Bhop|Random)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	EAlphaBotPattern Pattern;
+
+	/**
+	 * Seed for bot input (?Seed=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	int32 Seed;
+
+	/**
+	 * Seconds to run before measuring (?Warmup=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	float WarmupTime;
+
+	/**
+	 * Seconds to measure for (?Duration=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	float Duration;
+
+	/**
+	 * Distance between bots in the spawn grid
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	float BotSpacing;
+
+	/**
+	 * Generates benchmark geometry into the loaded map before spawning bots (?BenchmarkSeed=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	bool bGenerateBenchmarkMap;
+
+	UPROPERTY(EditAnywhere, Category = "Load Test", meta = (EditCondition = "bGenerateBenchmarkMap"))
+	FAlphaBenchmarkMapParams BenchmarkMapParams;
+
+	/**
+	 * Movement capture to replay instead of spawning bots (?ReplayCapture=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	FString CapturePath;
+
+	/**
+	 * Times the captured tick is replayed (?ReplayRepeat=)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	int32 CaptureRepeats;
+
+	/**
+	 * Quits once the report is written (?Exit)
+	 */
+	UPROPERTY(EditAnywhere, Category = "Load Test")
+	bool bExitWhenDone;
+
+private:
+	void SpawnBots();
+	void WriteReport() const;
+	void ReplayCapture();
+	void SaveReport(const TSharedRef<class FJsonObject>& Root, const FString& DefaultName) const;
+
+	TArray<float> FrameTimes;
+	TArray<float> MovementTimes;
+	FAlphaMovementCounters LastCounters;
+	FAlphaMovementCounters StartCounters;
+	FAlphaMovementCounters EndCounters;
+	FString ReportPath;
+	uint64 StartReplicationBytes;
+	uint64 EndReplicationBytes;
+	double SpeedSum;
+	float MaxSpeed;
+	int32 NumSpeedSamples;
+	float ElapsedTime;
+	float MeasuredTime;
+	bool bFinished;
+};
@@ -0,0 +1,181 @@
+#include "FAlphaBenchmarkMapGenerator.h"
+#include "Alpha/Character/AAlphaBaseCharacter.h"
+#include "Alpha/Character/FAlphaTrajectory.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerStart.h"
+
+const FName FAlphaBenchmarkMapGenerator::SurfRampTag(TEXT("SurfRamp"));
+
+// the engine cube is 100 units on each side with its pivot in the center
+constexpr float CubeSize = 100.0f;
+constexpr float SlabThickness = 50.0f;
+constexpr float FloorZ = -1000.0f;
+
+static bool SpawnBox(UWorld* World, UStaticMesh* Mesh, const FVector& Center, const FRotator& Rotation, const FVector& Size, FName Tag = NAME_None)
+{
+	const FTransform Transform(Rotation, Center, Size / CubeSize);
+	AStaticMeshActor* Actor = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+
+	if (Actor == nullptr)
+		return false;
+
+	// static components can't change mesh once registered, so set it before spawning finishes
+	Actor->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+
+	if (!Tag.IsNone())
+		Actor->Tags.Add(Tag);
+
+	Actor->FinishSpawning(Transform);
+	return true;
+}
+
+static const UAlphaMovementConfig* GetDefaultMovement()
+{
+	const UAlphaMovementConfig* Movement = Cast<UAlphaMovementConfig>(GetDefault<AAlphaBaseCharacter>()->GetCharacterMovement());
+	return Movement ? Movement : GetDefault<UAlphaMovementConfig>();
+}
+
+TArray<float> FAlphaBenchmarkMapGenerator::GetClassifiedRampAngles()
+{
+	const UAlphaMovementConfig* Movement = GetDefaultMovement();
+	const float WalkableAngle = FMath::RadiansToDegrees(FMath::Acos(Movement->GetDefaultWalkableFloorZ()));
+	const float SlidingAngle = FMath::RadiansToDegrees(FMath::Acos(UAlphaMovementConfig::GetSlidingWalkableFloorZ()));
+
+	return {
+		// walkable at any speed
+		0.5f * SlidingAngle,
+		// walkable when slow, slid on at slope speed
+		0.5f * (SlidingAngle + WalkableAngle),
+		// just past walkable, where catching air matters most
+		WalkableAngle + 5.0f,
+		// steep surf
+		0.5f * (WalkableAngle + 90.0f)
+	};
+}
+
+TArray<float> FAlphaBenchmarkMapGenerator::GetClassifiedStepHeights()
+{
+	const UAlphaMovementConfig* Movement = GetDefaultMovement();
+	const float MinStepHeight = Movement->GetMinStepHeight();
+	const float DefaultStepHeight = Movement->GetDefaultStepHeight();
+
+	return {
+		// climbable at any speed
+		0.5f * MinStepHeight,
+		// climbable when slow, blocks at slope speed
+		0.5f * (MinStepHeight + DefaultStepHeight),
+		// just climbable when slow
+		DefaultStepHeight - 1.0f,
+		// never climbable
+		DefaultStepHeight + 5.0f
+	};
+}
+
+int32 FAlphaBenchmarkMapGenerator::Generate(UWorld* World, const FAlphaBenchmarkMapParams& Params)
+{
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+	if (World == nullptr || Cube == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaBenchmarkMapGenerator::Generate() missing world or cube mesh"));
+		return 0;
+	}
+
+	FRandomStream RandomStream(Params.Seed);
+	int32 NumActors = 0;
+	float LaneY = 0.0f;
+	float MaxX = 0.0f;
+
+	// surf ramps, two slabs meeting at a ridge and split into pieces along their length
+	const TArray<float> RampAngles = Params.RampAngles.Num() > 0 ? Params.RampAngles : GetClassifiedRampAngles();
+	const int32 NumPieces = FMath::Max(Params.SeamsPerRamp, 0) + 1;
+	const float PieceLength = Params.RampLength / NumPieces;
+	const float HalfWidth = 0.5f * Params.RampWidth;
+
+	for (const float RampAngle : RampAngles)
+	{
+		const float RidgeHeight = Params.RampWidth * FMath::Sin(FMath::DegreesToRadians(RampAngle)) + 200.0f;
+		LaneY += 1.5f * Params.RampWidth;
+
+		for (int32 Piece = 0; Piece < NumPieces; Piece++)
+		{
+			for (const float Side : { -1.0f, 1.0f })
+			{
+				const float Angle = FMath::DegreesToRadians(RampAngle + RandomStream.FRandRange(-Params.SeamAngleJitter, Params.SeamAngleJitter));
+				const float Height = RidgeHeight + RandomStream.FRandRange(-Params.SeamHeightJitter, Params.SeamHeightJitter);
+				const FVector Normal(0.0f, Side * FMath::Sin(Angle), FMath::Cos(Angle));
+				const FVector TopCenter((Piece + 0.5f) * PieceLength, LaneY + Side * HalfWidth * FMath::Cos(Angle), Height - HalfWidth * FMath::Sin(Angle));
+				const FRotator Rotation = FRotationMatrix::MakeFromXZ(FVector::ForwardVector, Normal).Rotator();
+
+				NumActors += SpawnBox(World, Cube, TopCenter - Normal * (0.5f * SlabThickness), Rotation, FVector(PieceLength, Params.RampWidth, SlabThickness), SurfRampTag);
+			}
+		}
+
+		LaneY += 1.5f * Params.RampWidth;
+		MaxX = FMath::Max(MaxX, Params.RampLength);
+	}
+
+	// bhop platforms spaced by the distance a jump covers at max walk speed
+	const UAlphaMovementConfig* Movement = GetDefaultMovement();
+	const FAlphaTrajectoryParams TrajectoryParams = Movement->MakeTrajectoryParams(World->GetGravityZ() * Movement->GravityScale, Movement->MaxWalkSpeed);
+
+	FAlphaTrajectoryCandidate Jump;
+	Jump.Velocity = FVector(0.0f, 0.0f, Movement->JumpZVelocity);
+
+	const float AirTime = FMath::Max(FAlphaTrajectory::SolveTimeToHeight(TrajectoryParams, Jump, 0.0f), 0.1f);
+	const float JumpReach = AirTime * Movement->MaxWalkSpeed;
+	float PlatformX = 0.0f;
+
+	LaneY += Params.RampWidth;
+	NumActors += SpawnBox(World, Cube, FVector(-500.0f, LaneY, -50.0f), FRotator::ZeroRotator, FVector(1000.0f, Params.BhopPlatformSize, 100.0f));
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	NumActors += World->SpawnActor<APlayerStart>(FVector(-500.0f, LaneY, 150.0f), FRotator::ZeroRotator, SpawnParams) != nullptr;
+
+	for (int32 Platform = 0; Platform < Params.NumBhopPlatforms; Platform++)
+	{
+		PlatformX += JumpReach * RandomStream.FRandRange(0.5f, 0.9f);
+
+		const float PlatformZ = RandomStream.FRandRange(-1.0f, 1.0f) * Movement->GetDefaultStepHeight();
+		const FVector Center(PlatformX + 0.5f * Params.BhopPlatformSize, LaneY, PlatformZ - 50.0f);
+
+		NumActors += SpawnBox(World, Cube, Center, FRotator::ZeroRotator, FVector(Params.BhopPlatformSize, Params.BhopPlatformSize, 100.0f));
+		PlatformX += Params.BhopPlatformSize;
+	}
+
+	LaneY += Params.RampWidth;
+	MaxX = FMath::Max(MaxX, PlatformX);
+
+	// stair fields, one per step height
+	const TArray<float> StepHeights = Params.StepHeights.Num() > 0 ? Params.StepHeights : GetClassifiedStepHeights();
+	const float StairWidth = 400.0f;
+
+	for (const float StepHeight : StepHeights)
+	{
+		LaneY += StairWidth + 200.0f;
+		NumActors += SpawnBox(World, Cube, FVector(-500.0f, LaneY, -50.0f), FRotator::ZeroRotator, FVector(1000.0f, StairWidth, 100.0f));
+
+		for (int32 Step = 0; Step < Params.StepsPerField; Step++)
+		{
+			const float Top = (Step + 1) * StepHeight;
+			const FVector Center((Step + 0.5f) * Params.StepDepth, LaneY, 0.5f * (Top - 100.0f));
+
+			NumActors += SpawnBox(World, Cube, Center, FRotator::ZeroRotator, FVector(Params.StepDepth, StairWidth, Top + 100.0f));
+		}
+
+		MaxX = FMath::Max(MaxX, Params.StepsPerField * Params.StepDepth);
+	}
+
+	// catch everything which falls off
+	const FVector FloorMin(-2000.0f, -1000.0f, FloorZ - 100.0f);
+	const FVector FloorMax(MaxX + 2000.0f, LaneY + 1000.0f, FloorZ);
+	NumActors += SpawnBox(World, Cube, 0.5f * (FloorMin + FloorMax), FRotator::ZeroRotator, FloorMax - FloorMin);
+
+	UE_LOG(LogTemp, Display, TEXT("FAlphaBenchmarkMapGenerator::Generate() seed %d spawned %d actors"), Params.Seed, NumActors);
+
+	return NumActors;
+}
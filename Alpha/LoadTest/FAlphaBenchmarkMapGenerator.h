@@ -0,0 +1,89 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "FAlphaBenchmarkMapGenerator.generated.h"
+
+/**
+ * Layout of a generated benchmark level, the same seed and params always build the same level
+ */
+USTRUCT(BlueprintType)
+struct FAlphaBenchmarkMapParams
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	int32 Seed = 1;
+
+	/**
+	 * Ramp angles (deg from horizontal), empty picks one angle for each surface class the movement reacts to
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	TArray<float> RampAngles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	float RampLength = 6000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	float RampWidth = 800.0f;
+
+	/**
+	 * Number of seams along each ramp, each seam splits the ramp into another piece of geometry
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	int32 SeamsPerRamp = 8;
+
+	/**
+	 * Max angle (deg) a ramp piece may be tilted from its neighbour, non zero values produce bogus seam normals
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	float SeamAngleJitter = 0.5f;
+
+	/**
+	 * Max height (units) a ramp piece may be offset from its neighbour
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Surf")
+	float SeamHeightJitter = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Bhop")
+	int32 NumBhopPlatforms = 24;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Bhop")
+	float BhopPlatformSize = 200.0f;
+
+	/**
+	 * Step heights (units) of the stair fields, empty picks one height for each step class the movement reacts to
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Stairs")
+	TArray<float> StepHeights;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Stairs")
+	int32 StepsPerField = 12;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark|Stairs")
+	float StepDepth = 40.0f;
+};
+
+/**
+ * Builds deterministic surf, bhop and stair geometry for movement and collision benchmarks.
+ * Ramp pieces are tagged with SurfRampTag so other tools can find them.
+ */
+class FAlphaBenchmarkMapGenerator
+{
+public:
+	static const FName SurfRampTag;
+
+	/**
+	 * Spawns the benchmark geometry into a world
+	 * @return Number of actors spawned
+	 */
+	static int32 Generate(UWorld* World, const FAlphaBenchmarkMapParams& Params);
+
+	/**
+	 * Returns ramp angles on each side of the walkable floor thresholds used by UAlphaMovementConfig
+	 */
+	static TArray<float> GetClassifiedRampAngles();
+
+	/**
+	 * Returns step heights on each side of the dynamic step heights used by UAlphaMovementConfig
+	 */
+	static TArray<float> GetClassifiedStepHeights();
+};
@@ -0,0 +1,67 @@
+#include "UAlphaBenchmarkMapCommandlet.h"
+#include "FAlphaBenchmarkMapGenerator.h"
+#include "Engine/World.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UAlphaBenchmarkMapCommandlet::UAlphaBenchmarkMapCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAlphaBenchmarkMapCommandlet::Main(const FString& Params)
+{
+	FAlphaBenchmarkMapParams MapParams;
+	FParse::Value(*Params, TEXT("Seed="), MapParams.Seed);
+	FParse::Value(*Params, TEXT("Seams="), MapParams.SeamsPerRamp);
+	FParse::Value(*Params, TEXT("SeamJitter="), MapParams.SeamAngleJitter);
+	FParse::Value(*Params, TEXT("Platforms="), MapParams.NumBhopPlatforms);
+	FParse::Value(*Params, TEXT("Steps="), MapParams.StepsPerField);
+
+	FString Angles;
+
+	if (FParse::Value(*Params, TEXT("Angles="), Angles))
+	{
+		TArray<FString> AngleStrings;
+		Angles.ParseIntoArray(AngleStrings, TEXT(","));
+
+		for (const FString& Angle : AngleStrings)
+			MapParams.RampAngles.Add(FCString::Atof(*Angle));
+	}
+
+	FString PackageName = FString::Printf(TEXT("/Game/Benchmark/AlphaBenchmark_%d"), MapParams.Seed);
+	FParse::Value(*Params, TEXT("Map="), PackageName);
+
+#if WITH_EDITOR
+	UPackage* Package = CreatePackage(*PackageName);
+	UWorld* World = UWorld::CreateWorld(EWorldType::Editor, false, FName(*FPackageName::GetShortName(PackageName)), Package);
+	World->SetFlags(RF_Public | RF_Standalone);
+
+	const int32 NumActors = FAlphaBenchmarkMapGenerator::Generate(World, MapParams);
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetMapPackageExtension());
+	const bool bSaved = UPackage::SavePackage(Package, World, *Filename, SaveArgs);
+
+	World->DestroyWorld(false);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UAlphaBenchmarkMapCommandlet failed to save %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UAlphaBenchmarkMapCommandlet saved %s with %d actors"), *Filename, NumActors);
+	return 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("UAlphaBenchmarkMapCommandlet requires an editor build"));
+	return 1;
+#endif
+}
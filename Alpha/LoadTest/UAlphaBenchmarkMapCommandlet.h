@@ -0,0 +1,19 @@
+#pragma once
+#include "Commandlets/Commandlet.h"
+#include "UAlphaBenchmarkMapCommandlet.generated.h"
+
+/**
+ * Builds a benchmark level with FAlphaBenchmarkMapGenerator and saves it as a map package.
+ *
+ * UnrealEditor-Cmd Alpha.uproject -run=AlphaBenchmarkMap -Seed=7 -Seams=32 -SeamJitter=1 -Angles=30,50,70 -Map=/Game/Benchmark/Surf_7
+ */
+UCLASS()
+class UAlphaBenchmarkMapCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlphaBenchmarkMapCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
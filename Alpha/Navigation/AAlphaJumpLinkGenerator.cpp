@@ -0,0 +1,230 @@
+#include "AAlphaJumpLinkGenerator.h"
+#include "Alpha/Character/AAlphaBaseCharacter.h"
+#include "Alpha/Character/FAlphaTrajectory.h"
+#include "Async/ParallelFor.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavMesh/RecastNavMesh.h"
+
+namespace
+{
+	/**
+	 * A point on a navmesh boundary edge and the direction leaving the navmesh
+	 */
+	struct FJumpLinkSample
+	{
+		FVector Location;
+		FVector Outward;
+		NavNodeRef Poly;
+	};
+
+	struct FJumpLinkResult
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		bool bValid = false;
+	};
+}
+
+AAlphaJumpLinkGenerator::AAlphaJumpLinkGenerator()
+{
+	PointLinks.Empty();
+
+	GenerationExtent = FVector(2000.0f, 2000.0f, 1000.0f);
+	RunUpSpeeds = { 900.0f, 1200.0f };
+	EdgeSampleSpacing = 100.0f;
+	MinLinkDistance = 150.0f;
+	LinkSpacing = 150.0f;
+	ArcTimeStep = 0.05f;
+	MaxAirTime = 2.0f;
+	NumGeneratedLinks = 0;
+}
+
+FBox AAlphaJumpLinkGenerator::GetGenerationBounds() const
+{
+	return FBox::BuildAABB(GetActorLocation(), GenerationExtent);
+}
+
+void AAlphaJumpLinkGenerator::ClearJumpLinks()
+{
+	Modify();
+	PointLinks.Reset();
+	NumGeneratedLinks = 0;
+	UNavigationSystemV1::UpdateActorInNavOctree(*this);
+}
+
+void AAlphaJumpLinkGenerator::GenerateJumpLinks()
+{
+#if WITH_RECAST
+	UWorld* World = GetWorld();
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+	const ARecastNavMesh* NavMesh = NavSys ? Cast<ARecastNavMesh>(NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate)) : nullptr;
+
+	if (NavMesh == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AAlphaJumpLinkGenerator::GenerateJumpLinks() no recast navmesh"));
+		return;
+	}
+
+	// tuning comes from the class defaults so no character has to be spawned
+	const AAlphaBaseCharacter* Character = CharacterClass ? CharacterClass->GetDefaultObject<AAlphaBaseCharacter>() : GetDefault<AAlphaBaseCharacter>();
+	const UAlphaMovementConfig* Movement = Cast<UAlphaMovementConfig>(Character->GetCharacterMovement());
+
+	if (Movement == nullptr)
+		Movement = GetDefault<UAlphaMovementConfig>();
+
+	float Radius;
+	float HalfHeight;
+	Character->GetCapsuleComponent()->GetScaledCapsuleSize(Radius, HalfHeight);
+
+	FAlphaTrajectoryParams Params = Movement->MakeTrajectoryParams(World->GetGravityZ() * Movement->GravityScale, Movement->MaxWalkSpeed);
+	Params.CapsuleRadius = Radius;
+	Params.CapsuleHalfHeight = HalfHeight;
+
+	TArray<float> Speeds = RunUpSpeeds;
+	Speeds.AddUnique(Movement->MaxWalkSpeed);
+
+	const FBox Bounds = GetGenerationBounds();
+	const FVector ProbeExtent(Radius * 0.5f, Radius * 0.5f, Movement->MaxStepHeight);
+	const float SampleSpacing = FMath::Max(EdgeSampleSpacing, 1.0f);
+
+	// collect samples along every edge which has no navmesh on its outer side
+	TArray<FJumpLinkSample> Samples;
+	TArray<FNavPoly> Polys;
+	TArray<FVector> Verts;
+
+	for (int32 TileIndex = 0; TileIndex < NavMesh->GetNavMeshTilesCount(); TileIndex++)
+	{
+		Polys.Reset();
+
+		if (!NavMesh->GetPolysInTile(TileIndex, Polys))
+			continue;
+
+		for (const FNavPoly& Poly : Polys)
+		{
+			Verts.Reset();
+
+			if (!Bounds.IsInside(Poly.Center) || !NavMesh->GetPolyVerts(Poly.Ref, Verts))
+				continue;
+
+			for (int32 Index = 0; Index < Verts.Num(); Index++)
+			{
+				const FVector& EdgeStart = Verts[Index];
+				const FVector& EdgeEnd = Verts[(Index + 1) % Verts.Num()];
+				const FVector Edge = EdgeEnd - EdgeStart;
+				const FVector EdgeCenter = 0.5f * (EdgeStart + EdgeEnd);
+				const float EdgeLength = Edge.Size2D();
+
+				if (EdgeLength < KINDA_SMALL_NUMBER)
+					continue;
+
+				FVector Outward = FVector(Edge.Y, -Edge.X, 0.0f).GetSafeNormal();
+
+				if ((Outward | (EdgeCenter - Poly.Center)) < 0.0f)
+					Outward = -Outward;
+
+				FNavLocation Neighbour;
+
+				if (NavMesh->ProjectPoint(EdgeCenter + Outward * Radius, Neighbour, ProbeExtent))
+					continue;
+
+				const int32 NumEdgeSamples = FMath::Max(1, FMath::FloorToInt(EdgeLength / SampleSpacing));
+
+				for (int32 SampleIndex = 0; SampleIndex < NumEdgeSamples; SampleIndex++)
+				{
+					const float Alpha = (SampleIndex + 0.5f) / NumEdgeSamples;
+					Samples.Add({ FMath::Lerp(EdgeStart, EdgeEnd, Alpha), Outward, Poly.Ref });
+				}
+			}
+		}
+	}
+
+	// sweep every sample/speed pair along its jump arc, queries are read only so this can run wide
+	TArray<FJumpLinkResult> Results;
+	Results.SetNum(Samples.Num() * Speeds.Num());
+
+	const float WalkableFloorZ = Movement->GetWalkableFloorZ();
+	const float JumpZVelocity = Movement->JumpZVelocity;
+	const float TimeStep = FMath::Max(ArcTimeStep, 0.005f);
+	const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(Radius, HalfHeight);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AlphaJumpLinkArc), false, this);
+
+	ParallelFor(Results.Num(), [&](int32 Index)
+	{
+		const FJumpLinkSample& Sample = Samples[Index / Speeds.Num()];
+		const float Speed = Speeds[Index % Speeds.Num()];
+
+		FAlphaTrajectoryCandidate Candidate;
+		Candidate.Origin = Sample.Location + FVector(0.0f, 0.0f, HalfHeight + MAX_FLOOR_DIST);
+		Candidate.Velocity = Sample.Outward * Speed + FVector(0.0f, 0.0f, JumpZVelocity);
+		Candidate.WishDirection = Sample.Outward;
+
+		FVector Previous = Candidate.Origin;
+
+		for (float Time = TimeStep; Time <= MaxAirTime; Time += TimeStep)
+		{
+			const FVector Next = FAlphaTrajectory::EvaluatePosition(Params, Candidate, Time);
+			FHitResult Hit;
+
+			if (!World->SweepSingleByChannel(Hit, Previous, Next, FQuat::Identity, ECC_Pawn, CapsuleShape, QueryParams))
+			{
+				Previous = Next;
+				continue;
+			}
+
+			// the arc is blocked, only coming down on a walkable floor with navmesh counts as a landing
+			const bool bDescending = FAlphaTrajectory::EvaluateVelocity(Params, Candidate, Time).Z <= 0.0f;
+
+			if (!bDescending || Hit.ImpactNormal.Z < WalkableFloorZ)
+				return;
+
+			FNavLocation Landing;
+
+			if (!NavMesh->ProjectPoint(Hit.Location - FVector(0.0f, 0.0f, HalfHeight), Landing, ProbeExtent) || Landing.NodeRef == Sample.Poly)
+				return;
+
+			if (FVector::Dist2D(Sample.Location, Landing.Location) < MinLinkDistance)
+				return;
+
+			Results[Index].Start = Sample.Location;
+			Results[Index].End = Landing.Location;
+			Results[Index].bValid = true;
+			return;
+		}
+	});
+
+	Modify();
+	PointLinks.Reset();
+
+	const FTransform& ActorTransform = GetActorTransform();
+	const float LinkSpacingSq = FMath::Square(LinkSpacing);
+
+	for (const FJumpLinkResult& Result : Results)
+	{
+		if (!Result.bValid)
+			continue;
+
+		const FVector Left = ActorTransform.InverseTransformPosition(Result.Start);
+		const FVector Right = ActorTransform.InverseTransformPosition(Result.End);
+
+		// quadratic, but this only runs offline and neighbouring samples produce near identical links
+		const bool bDuplicate = PointLinks.ContainsByPredicate([&](const FNavigationLink& Link)
+		{
+			return FVector::DistSquared(Link.Left, Left) < LinkSpacingSq && FVector::DistSquared(Link.Right, Right) < LinkSpacingSq;
+		});
+
+		if (bDuplicate)
+			continue;
+
+		FNavigationLink& Link = PointLinks.Emplace_GetRef(Left, Right);
+		Link.Direction = ENavLinkDirection::LeftToRight;
+		Link.SnapRadius = Radius;
+	}
+
+	NumGeneratedLinks = PointLinks.Num();
+	UNavigationSystemV1::UpdateActorInNavOctree(*this);
+
+	UE_LOG(LogTemp, Display, TEXT("AAlphaJumpLinkGenerator::GenerateJumpLinks() %d links from %d edge samples"), NumGeneratedLinks, Samples.Num());
+#endif
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "Navigation/NavLinkProxy.h"
+#include "AAlphaJumpLinkGenerator.generated.h"
+
+class AAlphaBaseCharacter;
+
+/**
+ * Generates one way navigation links across gaps which can be cleared with the Alpha jump arc.
+ * Links are stored as point links on this proxy, so they are baked into the navmesh and cost nothing at runtime.
+ */
+UCLASS()
+class AAlphaJumpLinkGenerator : public ANavLinkProxy
+{
+	GENERATED_BODY()
+
+public:
+	AAlphaJumpLinkGenerator();
+
+	/**
+	 * Samples navmesh boundary edges inside the generation bounds and rebuilds the jump links
+	 */
+	UFUNCTION(CallInEditor, Category = "Jump Links")
+	void GenerateJumpLinks();
+
+	/**
+	 * Removes every generated jump link
+	 */
+	UFUNCTION(CallInEditor, Category = "Jump Links")
+	void ClearJumpLinks();
+
+	/**
+	 * Returns the world space box which navmesh edges are sampled in
+	 */
+	FBox GetGenerationBounds() const;
+
+protected:
+	/**
+	 * Character whose movement tuning (jump velocity, gravity, air acceleration) defines the jump arcs
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	TSubclassOf<AAlphaBaseCharacter> CharacterClass;
+
+	/**
+	 * Half size of the box around this actor which navmesh edges are sampled in
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	FVector GenerationExtent;
+
+	/**
+	 * Extra horizontal take off speeds (unit/s) to test, such as bhop speeds. The max walk speed is always tested
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	TArray<float> RunUpSpeeds;
+
+	/**
+	 * Distance between samples along a navmesh boundary edge
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	float EdgeSampleSpacing;
+
+	/**
+	 * Jumps which land closer than this (horizontally) to where they started are discarded
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	float MinLinkDistance;
+
+	/**
+	 * Links whose ends are both within this distance of an existing link are discarded
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	float LinkSpacing;
+
+	/**
+	 * Time step used when sweeping along a jump arc
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	float ArcTimeStep;
+
+	/**
+	 * Max time (in seconds) a jump may stay in the air
+	 */
+	UPROPERTY(EditAnywhere, Category = "Jump Links")
+	float MaxAirTime;
+
+	UPROPERTY(VisibleAnywhere, Category = "Jump Links")
+	int32 NumGeneratedLinks;
+};
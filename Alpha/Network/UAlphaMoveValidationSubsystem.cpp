@@ -0,0 +1,142 @@
+#include "UAlphaMoveValidationSubsystem.h"
+#include "Alpha/Alpha.h"
+#include "Alpha/Character/UAlphaMovementConfig.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Move Validation"), STAT_AlphaMoveValidation, STATGROUP_AlphaMovement);
+
+static TAutoConsoleVariable<int32> CVarMoveValidation(
+	TEXT("alpha.MoveValidation.Enable"),
+	1,
+	TEXT("Checks the ground clients claim to cover against the air strafe model. 0: off, 1: flag, 2: flag and correct"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarMoveValidationSpeedTolerance(
+	TEXT("alpha.MoveValidation.SpeedTolerance"),
+	25.0f,
+	TEXT("Speed (unit/s) a move may gain on top of what the movement model allows"),
+	ECVF_Default
+);
+
+static TAutoConsoleVariable<float> CVarMoveValidationDistanceTolerance(
+	TEXT("alpha.MoveValidation.DistanceTolerance"),
+	5.0f,
+	TEXT("Distance (unit) between two claimed client locations on top of what the allowed speed covers"),
+	ECVF_Default
+);
+
+bool UAlphaMoveValidationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAlphaMoveValidationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAlphaMoveValidationSubsystem, STATGROUP_Tickables);
+}
+
+void UAlphaMoveValidationSubsystem::AddSample(UAlphaMovementConfig* Component, const FAlphaMoveValidationSample& Sample)
+{
+	if (CVarMoveValidation.GetValueOnGameThread() == 0 || Sample.NumUpdates <= 0)
+		return;
+
+	SampleComponents.Add(Component);
+	StartSpeedSq.Add(Sample.StartVelocity.SizeSquared2D());
+	ClaimedDistance.Add(Sample.ClaimedDistance);
+	DeltaTimes.Add(Sample.DeltaTime);
+	NumUpdates.Add(Sample.NumUpdates);
+	UpdateAccelerations.Add(Sample.Acceleration * Sample.DeltaTime / Sample.NumUpdates);
+	SpeedCaps.Add(Sample.SpeedCap);
+	ExtraSpeeds.Add(Sample.ExtraSpeed);
+}
+
+void UAlphaMoveValidationSubsystem::Tick(float DeltaTime)
+{
+	if (SampleComponents.Num() == 0)
+		return;
+
+	ValidateSamples();
+
+	const bool bCorrect = CVarMoveValidation.GetValueOnGameThread() >= 2;
+	Violations.Reset();
+
+	for (int32 Index = 0; Index < SampleComponents.Num(); Index++)
+	{
+		if (AllowedSpeeds[Index] <= 0.0f)
+			continue;
+
+		// components may have been destroyed since their move arrived
+		UAlphaMovementConfig* Component = SampleComponents[Index].Get();
+
+		if (Component == nullptr)
+			continue;
+
+		Violations.FindOrAdd(Component)++;
+
+		if (bCorrect)
+			Component->CorrectInvalidMove(AllowedSpeeds[Index]);
+	}
+
+	for (const TPair<UAlphaMovementConfig*, int32>& Violation : Violations)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UAlphaMoveValidationSubsystem %s failed %d moves"), *GetNameSafe(Violation.Key->GetOwner()), Violation.Value);
+		OnMoveViolation.Broadcast(Violation.Key, Violation.Value);
+	}
+
+	SampleComponents.Reset();
+	StartSpeedSq.Reset();
+	ClaimedDistance.Reset();
+	DeltaTimes.Reset();
+	NumUpdates.Reset();
+	UpdateAccelerations.Reset();
+	SpeedCaps.Reset();
+	ExtraSpeeds.Reset();
+}
+
+void UAlphaMoveValidationSubsystem::ValidateSamples()
+{
+	SCOPE_CYCLE_COUNTER(STAT_AlphaMoveValidation);
+
+	const int32 NumSamples = SampleComponents.Num();
+	const int32 NumPadded = Align(NumSamples, 4);
+
+	// pad with samples that always pass so every lane is valid
+	StartSpeedSq.SetNumZeroed(NumPadded);
+	ClaimedDistance.SetNumZeroed(NumPadded);
+	DeltaTimes.SetNumZeroed(NumPadded);
+	NumUpdates.SetNumZeroed(NumPadded);
+	UpdateAccelerations.SetNumZeroed(NumPadded);
+	SpeedCaps.SetNumZeroed(NumPadded);
+	ExtraSpeeds.SetNumZeroed(NumPadded);
+	AllowedSpeeds.SetNumUninitialized(NumPadded);
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+	const VectorRegister4Float SpeedTolerance = VectorSetFloat1(CVarMoveValidationSpeedTolerance.GetValueOnGameThread());
+	const VectorRegister4Float DistanceTolerance = VectorSetFloat1(CVarMoveValidationDistanceTolerance.GetValueOnGameThread());
+
+	for (int32 Base = 0; Base < NumPadded; Base += 4)
+	{
+		const VectorRegister4Float StartSq = VectorLoad(&StartSpeedSq[Base]);
+		const VectorRegister4Float Claimed = VectorLoad(&ClaimedDistance[Base]);
+		const VectorRegister4Float Time = VectorLoad(&DeltaTimes[Base]);
+		const VectorRegister4Float Updates = VectorLoad(&NumUpdates[Base]);
+		const VectorRegister4Float Accel = VectorLoad(&UpdateAccelerations[Base]);
+		const VectorRegister4Float Cap = VectorLoad(&SpeedCaps[Base]);
+		const VectorRegister4Float Extra = VectorLoad(&ExtraSpeeds[Base]);
+
+		// max squared speed gain from one strafe update, it doesn't depend on the speed so updates add up
+		const VectorRegister4Float CappedGain = VectorMultiply(Cap, Cap);
+		const VectorRegister4Float PartialGain = VectorMultiply(Accel, VectorSubtract(VectorMultiply(Two, Cap), Accel));
+		const VectorRegister4Float GainSq = VectorMultiply(VectorSelect(VectorCompareGE(Accel, Cap), CappedGain, PartialGain), Updates);
+
+		const VectorRegister4Float Allowed = VectorAdd(VectorAdd(VectorSqrt(VectorAdd(StartSq, GainSq)), Extra), SpeedTolerance);
+
+		// the client can't claim to have covered more ground than the allowed speed covers
+		const VectorRegister4Float MaxDistance = VectorMultiplyAdd(Allowed, Time, DistanceTolerance);
+		const VectorRegister4Float Failed = VectorCompareGT(Claimed, MaxDistance);
+
+		VectorStore(VectorSelect(Failed, Allowed, Zero), &AllowedSpeeds[Base]);
+	}
+}
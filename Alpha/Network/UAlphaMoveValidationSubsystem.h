@@ -0,0 +1,95 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "UAlphaMoveValidationSubsystem.generated.h"
+
+class UAlphaMovementConfig;
+
+/**
+ * The moves a client made between two locations it claimed, as seen by the server
+ */
+struct FAlphaMoveValidationSample
+{
+	/**
+	 * Server velocity at the previous claimed location
+	 */
+	FVector StartVelocity = FVector::ZeroVector;
+
+	/**
+	 * Horizontal distance between the two claimed locations
+	 */
+	float ClaimedDistance = 0.0f;
+
+	/**
+	 * Time and number of movement updates between the two claimed locations
+	 */
+	float DeltaTime = 0.0f;
+	int32 NumUpdates = 0;
+
+	/**
+	 * Max acceleration (unit/s^2) along the wish direction and the speed it stops adding at, see CalcVelocity
+	 */
+	float Acceleration = 0.0f;
+	float SpeedCap = 0.0f;
+
+	/**
+	 * Speed gain from outside the strafe model, gravity and jumping
+	 */
+	float ExtraSpeed = 0.0f;
+};
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FAlphaMoveViolationDelegate, UAlphaMovementConfig*, int32 /* NumViolations */);
+
+/**
+ * Checks the ground clients claim to cover against the speed gain the air strafe model allows.
+ *
+ * The server's own simulation of a move can't break the model, so the check is on the locations the client reports.
+ * With an acceleration a = Acceleration * DeltaTime and a cap C, one update can add at most C^2 to the squared
+ * speed when a >= C and a * (2C - a) otherwise, so the distance between two claimed locations is bounded by the
+ * server's speed at the first one plus that gain for every update in between. Claims are only queued when they
+ * arrive and checked once per frame, four at a time, so the cost per RPC is a few stores.
+ */
+UCLASS()
+class UAlphaMoveValidationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void AddSample(UAlphaMovementConfig* Component, const FAlphaMoveValidationSample& Sample);
+
+	/**
+	 * Fired once per frame for every component which failed at least one move
+	 */
+	FAlphaMoveViolationDelegate OnMoveViolation;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void ValidateSamples();
+
+	TArray<TWeakObjectPtr<UAlphaMovementConfig>> SampleComponents;
+	TArray<float> StartSpeedSq;
+	TArray<float> ClaimedDistance;
+	TArray<float> DeltaTimes;
+	TArray<float> NumUpdates;
+
+	/**
+	 * Acceleration over the average update of each sample
+	 */
+	TArray<float> UpdateAccelerations;
+	TArray<float> SpeedCaps;
+	TArray<float> ExtraSpeeds;
+
+	/**
+	 * Allowed speed of each failed sample, zero for samples which passed
+	 */
+	TArray<float> AllowedSpeeds;
+
+	/**
+	 * Failed moves per component this frame, emptied at the start of the next so it keeps its allocation
+	 */
+	TMap<UAlphaMovementConfig*, int32> Violations;
+};
@@ -0,0 +1,181 @@
+#include "UAlphaReplicationGraph.h"
+#include "Alpha/Character/AAlphaBaseCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "EngineDefines.h"
+
+UAlphaReplicationGraphNode_CharacterGrid::UAlphaReplicationGraphNode_CharacterGrid()
+{
+	bRequiresPrepareForReplicationCall = true;
+}
+
+FIntPoint UAlphaReplicationGraphNode_CharacterGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UAlphaReplicationGraphNode_CharacterGrid::NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo)
+{
+	Characters.Add(ActorInfo.Actor);
+}
+
+bool UAlphaReplicationGraphNode_CharacterGrid::NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound)
+{
+	if (Characters.RemoveSingleSwap(ActorInfo.Actor) == 0)
+	{
+		if (bWarnIfNotFound)
+			UE_LOG(LogTemp, Warning, TEXT("UAlphaReplicationGraphNode_CharacterGrid %s was not in the grid"), *GetNameSafe(ActorInfo.Actor));
+
+		return false;
+	}
+
+	// the grid is only rebuilt next frame, connections may still gather this one
+	for (TPair<FIntPoint, FActorRepListRefView>& Cell : Cells)
+		Cell.Value.RemoveFast(ActorInfo.Actor);
+
+	return true;
+}
+
+void UAlphaReplicationGraphNode_CharacterGrid::NotifyResetAllNetworkActors()
+{
+	Characters.Reset();
+	Cells.Reset();
+}
+
+void UAlphaReplicationGraphNode_CharacterGrid::PrepareForReplication()
+{
+	// cells which stayed empty for a whole frame are dropped, the rest keep their allocation
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		if (It.Value().Num() == 0)
+			It.RemoveCurrent();
+		else
+			It.Value().Reset();
+	}
+
+	const UAlphaReplicationGraph* Graph = CastChecked<UAlphaReplicationGraph>(GraphGlobals->ReplicationGraph);
+
+	for (AActor* Actor : Characters)
+	{
+		// the graph reads rates from its own settings, the character changes them as it speeds up and slows down
+		Graph->UpdateCharacterSettings(Actor, GraphGlobals->GlobalActorReplicationInfoMap->Get(Actor).Settings);
+
+		const FVector Location = Actor->GetActorLocation();
+		const FVector Predicted = Location + Actor->GetVelocity() * LeadTime;
+
+		// cull distance around the path covered in the next LeadTime seconds
+		const FIntPoint Min = GetCell(Location.ComponentMin(Predicted) - FVector(CullDistance));
+		const FIntPoint Max = GetCell(Location.ComponentMax(Predicted) + FVector(CullDistance));
+
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+				Cells.FindOrAdd(FIntPoint(X, Y)).Add(Actor);
+		}
+	}
+}
+
+void UAlphaReplicationGraphNode_CharacterGrid::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+	TArray<FIntPoint, TInlineAllocator<4>> GatheredCells;
+
+	for (const FNetViewer& Viewer : Params.Viewers)
+	{
+		const FVector Velocity = Viewer.ViewTarget ? Viewer.ViewTarget->GetVelocity() : FVector::ZeroVector;
+
+		// also gather where the viewer is heading, characters there are sent before the viewer arrives
+		for (const FVector& Location : { Viewer.ViewLocation, Viewer.ViewLocation + Velocity * LeadTime })
+		{
+			const FIntPoint Cell = GetCell(Location);
+
+			if (GatheredCells.Contains(Cell))
+				continue;
+
+			GatheredCells.Add(Cell);
+
+			if (const FActorRepListRefView* List = Cells.Find(Cell))
+			{
+				if (List->Num() > 0)
+					Params.OutGatheredReplicationLists.AddReplicationActorList(*List);
+			}
+		}
+	}
+}
+
+void UAlphaReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	FClassReplicationInfo DefaultInfo;
+	DefaultInfo.SetCullDistanceSquared(FMath::Square(GridCullDistance));
+	GlobalActorReplicationInfoMap.SetClassInfo(AActor::StaticClass(), DefaultInfo);
+
+	// relevancy comes from the character grid, culling per connection again would only cost time
+	FClassReplicationInfo CharacterInfo;
+	CharacterInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(GetDefault<AAlphaBaseCharacter>()->NetUpdateFrequency);
+	CharacterInfo.SetCullDistanceSquared(0.0f);
+	GlobalActorReplicationInfoMap.SetClassInfo(AAlphaBaseCharacter::StaticClass(), CharacterInfo);
+}
+
+void UAlphaReplicationGraph::UpdateCharacterSettings(const AActor* Character, FClassReplicationInfo& Settings) const
+{
+	Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Character->NetUpdateFrequency);
+
+	// starving characters climb the list faster the higher their priority is over the class default
+	Settings.StarvationPriorityScale = Character->NetPriority / FMath::Max(GetDefault<AAlphaBaseCharacter>()->NetPriority, KINDA_SMALL_NUMBER);
+}
+
+void UAlphaReplicationGraph::InitGlobalGraphNodes()
+{
+	CharacterGridNode = CreateNewNode<UAlphaReplicationGraphNode_CharacterGrid>();
+	CharacterGridNode->CellSize = CharacterCellSize;
+	CharacterGridNode->CullDistance = CharacterCullDistance;
+	CharacterGridNode->LeadTime = CharacterLeadTime;
+	AddGlobalGraphNode(CharacterGridNode);
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(-UE_OLD_WORLD_MAX, -UE_OLD_WORLD_MAX);
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UAlphaReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager)
+{
+	Super::InitConnectionGraphNodes(ConnectionManager);
+
+	// adds the connection's player controller and view target
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* ConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(ConnectionNode, ConnectionManager);
+}
+
+void UAlphaReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	const AActor* Actor = ActorInfo.Actor;
+
+	if (Actor->IsA<APlayerController>())
+		return;
+
+	if (Actor->bAlwaysRelevant)
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+	else if (Actor->IsA<AAlphaBaseCharacter>())
+		CharacterGridNode->NotifyAddNetworkActor(ActorInfo);
+	else
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+}
+
+void UAlphaReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const AActor* Actor = ActorInfo.Actor;
+
+	if (Actor->IsA<APlayerController>())
+		return;
+
+	if (Actor->bAlwaysRelevant)
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+	else if (Actor->IsA<AAlphaBaseCharacter>())
+		CharacterGridNode->NotifyRemoveNetworkActor(ActorInfo);
+	else
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+}
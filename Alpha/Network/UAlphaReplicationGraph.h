@@ -0,0 +1,97 @@
+#pragma once
+#include "ReplicationGraph.h"
+#include "UAlphaReplicationGraph.generated.h"
+
+/**
+ * Spatial hash of replicated characters.
+ *
+ * Every frame each character is added to all cells within its cull distance of the box swept along its velocity
+ * for LeadTime seconds, so a connection only gathers the cell its viewer is in (and the cell the viewer is heading
+ * to) and still sees fast characters before they arrive. Gathering costs a couple of lookups per connection, the
+ * lists handed to the graph only hold the characters near the viewer.
+ */
+UCLASS()
+class UAlphaReplicationGraphNode_CharacterGrid : public UReplicationGraphNode
+{
+	GENERATED_BODY()
+
+public:
+	UAlphaReplicationGraphNode_CharacterGrid();
+
+	virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override;
+	virtual void NotifyResetAllNetworkActors() override;
+	virtual void PrepareForReplication() override;
+	virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+	/**
+	 * Size (in units) of a grid cell, should be in the order of CullDistance
+	 */
+	float CellSize = 10000.0f;
+
+	/**
+	 * Distance (in units) at which characters stop being relevant
+	 */
+	float CullDistance = 15000.0f;
+
+	/**
+	 * Time (in seconds) characters and viewers are predicted ahead along their velocity
+	 */
+	float LeadTime = 0.5f;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TArray<AActor*> Characters;
+	TMap<FIntPoint, FActorRepListRefView> Cells;
+};
+
+/**
+ * Replication graph for large lobbies, enable it with ReplicationDriverClassName="/Script/Alpha.AlphaReplicationGraph"
+ * on the net driver.
+ *
+ * Characters go through UAlphaReplicationGraphNode_CharacterGrid, always relevant actors through a single list,
+ * player controllers through the per connection node and everything else through the stock grid.
+ */
+UCLASS(Transient, Config=Engine)
+class UAlphaReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	/**
+	 * Copies a character's NetUpdateFrequency and NetPriority into its replication settings, the class settings
+	 * only hold the defaults
+	 */
+	void UpdateCharacterSettings(const AActor* Character, FClassReplicationInfo& Settings) const;
+
+	UPROPERTY(Config)
+	float CharacterCellSize = 10000.0f;
+
+	UPROPERTY(Config)
+	float CharacterCullDistance = 15000.0f;
+
+	UPROPERTY(Config)
+	float CharacterLeadTime = 0.5f;
+
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	UPROPERTY(Config)
+	float GridCullDistance = 15000.0f;
+
+	UPROPERTY()
+	UAlphaReplicationGraphNode_CharacterGrid* CharacterGridNode;
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+};
@@ -0,0 +1,201 @@
+#include "AAlphaGhostManager.h"
+#include "Alpha/Alpha.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ConstructorHelpers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ghost Upload"), STAT_AlphaGhostUpload, STATGROUP_AlphaMovement);
+DECLARE_CYCLE_STAT(TEXT("Ghost Interpolate"), STAT_AlphaGhostInterpolate, STATGROUP_AlphaMovement);
+
+AAlphaGhostManager::AAlphaGhostManager()
+{
+	GhostInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("GhostInstances"));
+	GhostInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GhostInstances->SetGenerateOverlapEvents(false);
+	GhostInstances->SetCanEverAffectNavigation(false);
+	GhostInstances->CastShadow = false;
+	GhostInstances->SetMobility(EComponentMobility::Movable);
+	RootComponent = GhostInstances;
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> CylinderMesh(TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+	GhostMesh = CylinderMesh.Object;
+	GhostMaterial = nullptr;
+	GhostScale = FVector(0.64f, 0.64f, 1.8f);
+	PlaybackRate = 1.0f;
+	bLoop = true;
+	GhostsPerBatch = 64;
+	bHasPendingTransforms = false;
+	PlaybackTime = 0.0f;
+
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
+	SetActorEnableCollision(false);
+}
+
+void AAlphaGhostManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	WaitForUpdate();
+
+	if (bHasPendingTransforms && Transforms.Num() == GhostInstances->GetInstanceCount())
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AlphaGhostUpload);
+		GhostInstances->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+	}
+
+	bHasPendingTransforms = false;
+
+	// interpolate the next frame while this one renders, assuming a similar frame time
+	const float Step = DeltaSeconds * PlaybackRate;
+	PlaybackTime += Step;
+	LaunchUpdate(PlaybackTime + Step);
+}
+
+void AAlphaGhostManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	WaitForUpdate();
+	Super::EndPlay(EndPlayReason);
+}
+
+int32 AAlphaGhostManager::AddGhost(const FString& Filename, float StartDelay)
+{
+	TSharedPtr<FAlphaDemoReader>& Reader = Readers.FindOrAdd(Filename);
+
+	if (!Reader.IsValid())
+	{
+		Reader = MakeShared<FAlphaDemoReader>();
+
+		if (!Reader->Open(Filename))
+		{
+			Readers.Remove(Filename);
+			return INDEX_NONE;
+		}
+	}
+
+	WaitForUpdate();
+
+	if (GhostInstances->GetStaticMesh() != GhostMesh)
+	{
+		GhostInstances->SetStaticMesh(GhostMesh);
+
+		if (GhostMaterial)
+			GhostInstances->SetMaterial(0, GhostMaterial);
+	}
+
+	FGhost& Ghost = Ghosts.AddDefaulted_GetRef();
+	Ghost.Reader = Reader;
+	Ghost.StartDelay = StartDelay;
+
+	// hidden until the first update places it
+	GhostInstances->AddInstance(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true);
+
+	return Ghosts.Num() - 1;
+}
+
+void AAlphaGhostManager::ClearGhosts()
+{
+	WaitForUpdate();
+
+	Ghosts.Reset();
+	Readers.Reset();
+	Transforms.Reset();
+	bHasPendingTransforms = false;
+	GhostInstances->ClearInstances();
+}
+
+void AAlphaGhostManager::RestartPlayback()
+{
+	WaitForUpdate();
+
+	PlaybackTime = 0.0f;
+
+	for (FGhost& Ghost : Ghosts)
+	{
+		Ghost.LoopOffset = 0.0f;
+		Ghost.bStarted = false;
+		Ghost.bFinished = false;
+	}
+}
+
+FTransform AAlphaGhostManager::EvaluateGhost(FGhost& Ghost, float Time) const
+{
+	const FAlphaDemoReader& Reader = *Ghost.Reader;
+	const float Duration = Reader.GetDuration();
+	float LocalTime = Time - Ghost.StartDelay - Ghost.LoopOffset;
+
+	if (LocalTime < 0.0f)
+		return FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector);
+
+	if (bLoop && Duration > KINDA_SMALL_NUMBER && LocalTime > Duration)
+	{
+		const float Loops = FMath::FloorToFloat(LocalTime / Duration);
+		Ghost.LoopOffset += Loops * Duration;
+		LocalTime -= Loops * Duration;
+		Ghost.bStarted = false;
+	}
+
+	if (!Ghost.bStarted)
+	{
+		Ghost.bStarted = true;
+		Ghost.bFinished = !Reader.Seek(LocalTime, Ghost.Cursor) || !Reader.ReadFrame(Ghost.Cursor, Ghost.Previous);
+		Ghost.Next = Ghost.Previous;
+	}
+
+	// cursors only move forward, so a ghost decodes each of its frames once
+	while (!Ghost.bFinished && Ghost.Next.Time < LocalTime)
+	{
+		Ghost.Previous = Ghost.Next;
+
+		if (!Reader.ReadFrame(Ghost.Cursor, Ghost.Next))
+		{
+			Ghost.Next = Ghost.Previous;
+			Ghost.bFinished = true;
+		}
+	}
+
+	const float Span = Ghost.Next.Time - Ghost.Previous.Time;
+	const float Alpha = Span > KINDA_SMALL_NUMBER ? FMath::Clamp((LocalTime - Ghost.Previous.Time) / Span, 0.0f, 1.0f) : 1.0f;
+
+	const FVector Location = FMath::Lerp(Ghost.Previous.Location, Ghost.Next.Location, Alpha);
+	const FRotator Rotation(0.0f, FMath::Lerp(Ghost.Previous.ControlRotation, Ghost.Next.ControlRotation, Alpha).Yaw, 0.0f);
+
+	return FTransform(Rotation, Location, GhostScale);
+}
+
+void AAlphaGhostManager::LaunchUpdate(float Time)
+{
+	if (Ghosts.Num() == 0)
+		return;
+
+	Transforms.SetNum(Ghosts.Num(), false);
+
+	UpdateTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Time]
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AlphaGhostInterpolate);
+
+		const int32 NumBatches = FMath::DivideAndRoundUp(Ghosts.Num(), FMath::Max(GhostsPerBatch, 1));
+
+		ParallelFor(NumBatches, [this, Time, NumBatches](int32 Batch)
+		{
+			const int32 First = Batch * Ghosts.Num() / NumBatches;
+			const int32 Last = (Batch + 1) * Ghosts.Num() / NumBatches;
+
+			for (int32 Index = First; Index < Last; Index++)
+				Transforms[Index] = EvaluateGhost(Ghosts[Index], Time);
+		});
+	});
+
+	bHasPendingTransforms = true;
+}
+
+void AAlphaGhostManager::WaitForUpdate()
+{
+	if (UpdateTask.IsValid())
+	{
+		UpdateTask.Wait();
+		UpdateTask = UE::Tasks::FTask();
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "GameFramework/Actor.h"
+#include "FAlphaDemo.h"
+#include "Tasks/Task.h"
+#include "AAlphaGhostManager.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/**
+ * Plays back recorded demos as ghosts.
+ *
+ * Every ghost is a single instance of one instanced static mesh with no collision, so thousands of ghosts cost one
+ * draw and no actors. Trajectories are interpolated on a worker task for the next frame while the game thread
+ * renders the current one, the game thread only uploads the finished transforms.
+ */
+UCLASS()
+class AAlphaGhostManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AAlphaGhostManager();
+
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Adds a ghost playing a demo file, files shared by several ghosts are only mapped once
+	 * @param StartDelay Seconds after the playback time the ghost starts moving
+	 * @return Ghost index, or INDEX_NONE if the demo could not be opened
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghosts")
+	int32 AddGhost(const FString& Filename, float StartDelay = 0.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "Ghosts")
+	void ClearGhosts();
+
+	/**
+	 * Restarts every ghost from the beginning of its demo
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ghosts")
+	void RestartPlayback();
+
+	int32 GetNumGhosts() const
+	{
+		return Ghosts.Num();
+	}
+
+protected:
+	UPROPERTY(VisibleAnywhere, Category = "Ghosts")
+	UInstancedStaticMeshComponent* GhostInstances;
+
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	UStaticMesh* GhostMesh;
+
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	UMaterialInterface* GhostMaterial;
+
+	/**
+	 * Scale applied to the ghost mesh
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	FVector GhostScale;
+
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	float PlaybackRate;
+
+	/**
+	 * Restart ghosts once they reach the end of their demo, otherwise they stay on their last frame
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	bool bLoop;
+
+	/**
+	 * Min ghosts per worker batch when interpolating
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ghosts")
+	int32 GhostsPerBatch;
+
+private:
+	struct FGhost
+	{
+		TSharedPtr<FAlphaDemoReader> Reader;
+		FAlphaDemoCursor Cursor;
+		FAlphaDemoFrame Previous;
+		FAlphaDemoFrame Next;
+		float StartDelay = 0.0f;
+		float LoopOffset = 0.0f;
+		bool bStarted = false;
+		bool bFinished = false;
+	};
+
+	/**
+	 * Steps a ghost's cursor up to the given demo time and returns its transform, runs on a worker
+	 */
+	FTransform EvaluateGhost(FGhost& Ghost, float Time) const;
+
+	void LaunchUpdate(float Time);
+	void WaitForUpdate();
+
+	TArray<FGhost> Ghosts;
+	TMap<FString, TSharedPtr<FAlphaDemoReader>> Readers;
+
+	/**
+	 * Written by the update task, only read by the game thread once the task is complete
+	 */
+	TArray<FTransform> Transforms;
+	UE::Tasks::FTask UpdateTask;
+	bool bHasPendingTransforms;
+	float PlaybackTime;
+};
@@ -0,0 +1,522 @@
+#include "FAlphaDemo.h"
+#include "Alpha/Character/UAlphaMovementConfig.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+constexpr uint32 DemoMagic = 0x4D444C41;
+constexpr uint32 DemoVersion = 1;
+constexpr int64 DemoHeaderSize = 16;
+constexpr int64 DemoFooterSize = 24;
+constexpr int64 DemoChunkEntrySize = 16;
+
+// time is stored in 0.1ms units and position in 1/32 units
+constexpr double DemoTimeUnit = 0.0001;
+constexpr double DemoLocationScale = 32.0;
+
+static void WriteVarUInt(TArray<uint8>& Out, uint32 Value)
+{
+	while (Value >= 0x80)
+	{
+		Out.Add(static_cast<uint8>(Value | 0x80));
+		Value >>= 7;
+	}
+
+	Out.Add(static_cast<uint8>(Value));
+}
+
+/**
+ * Zigzag encodes so small negative deltas stay small
+ */
+static void WriteVarInt(TArray<uint8>& Out, int32 Value)
+{
+	WriteVarUInt(Out, (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31));
+}
+
+static uint32 ReadVarUInt(const uint8* Data, int64 End, int64& Offset)
+{
+	uint32 Value = 0;
+
+	for (int32 Shift = 0; Offset < End && Shift < 35; Shift += 7)
+	{
+		const uint8 Byte = Data[Offset++];
+		Value |= static_cast<uint32>(Byte & 0x7F) << Shift;
+
+		if ((Byte & 0x80) == 0)
+			break;
+	}
+
+	return Value;
+}
+
+static int32 ReadVarInt(const uint8* Data, int64 End, int64& Offset)
+{
+	const uint32 Value = ReadVarUInt(Data, End, Offset);
+	return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+}
+
+template<typename T>
+static T ReadRaw(const uint8* Data, int64 Offset)
+{
+	T Value;
+	FMemory::Memcpy(&Value, Data + Offset, sizeof(T));
+	return Value;
+}
+
+static int16 QuantizeSpeed(float Value, float SpeedLimit)
+{
+	return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Value / SpeedLimit * 32767.0f), -32767, 32767));
+}
+
+static float DequantizeSpeed(int16 Value, float SpeedLimit)
+{
+	return Value * SpeedLimit / 32767.0f;
+}
+
+static FIntVector QuantizeLocation(const FVector& Location)
+{
+	return FIntVector(
+		FMath::RoundToInt(Location.X * DemoLocationScale),
+		FMath::RoundToInt(Location.Y * DemoLocationScale),
+		FMath::RoundToInt(Location.Z * DemoLocationScale)
+	);
+}
+
+/**
+ * Extrapolates the previous location with the previous velocity, both sides only use quantized state
+ */
+static FIntVector PredictLocation(const FAlphaDemoState& State, uint32 DeltaUnits, float SpeedLimit)
+{
+	const double Seconds = DeltaUnits * DemoTimeUnit;
+	FIntVector Result;
+
+	for (int32 Axis = 0; Axis < 3; Axis++)
+		Result[Axis] = State.Location[Axis] + FMath::RoundToInt(DequantizeSpeed(State.Velocity[Axis], SpeedLimit) * Seconds * DemoLocationScale);
+
+	return Result;
+}
+
+static void DecodeState(const FAlphaDemoState& State, float SpeedLimit, FAlphaDemoFrame& OutFrame)
+{
+	OutFrame.Time = static_cast<float>(State.TimeUnits * DemoTimeUnit);
+	OutFrame.Location = FVector(State.Location.X, State.Location.Y, State.Location.Z) / DemoLocationScale;
+	OutFrame.Velocity = FVector(DequantizeSpeed(State.Velocity[0], SpeedLimit), DequantizeSpeed(State.Velocity[1], SpeedLimit), DequantizeSpeed(State.Velocity[2], SpeedLimit));
+	OutFrame.ControlRotation = FRotator(FRotator::DecompressAxisFromShort(State.Rotation[0]), FRotator::DecompressAxisFromShort(State.Rotation[1]), FRotator::DecompressAxisFromShort(State.Rotation[2]));
+	OutFrame.MovementMode = State.MovementMode;
+}
+
+FAlphaDemoFrame FAlphaDemoFrame::Lerp(const FAlphaDemoFrame& A, const FAlphaDemoFrame& B, float Alpha)
+{
+	FAlphaDemoFrame Result;
+	Result.Time = FMath::Lerp(A.Time, B.Time, Alpha);
+	Result.Location = FMath::Lerp(A.Location, B.Location, Alpha);
+	Result.Velocity = FMath::Lerp(A.Velocity, B.Velocity, Alpha);
+	Result.ControlRotation = FMath::Lerp(A.ControlRotation, B.ControlRotation, Alpha);
+	Result.MovementMode = Alpha < 0.5f ? A.MovementMode : B.MovementMode;
+	return Result;
+}
+
+FAlphaDemoWriter::FAlphaDemoWriter()
+{
+	SpeedLimit = 1.0f;
+	LastTime = 0.0f;
+	FramesPerChunk = 256;
+	FramesInChunk = 0;
+	NumFrames = 0;
+}
+
+FAlphaDemoWriter::~FAlphaDemoWriter()
+{
+	Close();
+}
+
+bool FAlphaDemoWriter::Open(const FString& Filename, float AxisSpeedLimit, int32 InFramesPerChunk)
+{
+	Close();
+
+	FileWriter.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+
+	if (!FileWriter.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaDemoWriter::Open() failed to create %s"), *Filename);
+		return false;
+	}
+
+	SpeedLimit = FMath::Max(AxisSpeedLimit, 1.0f);
+	FramesPerChunk = FMath::Max(InFramesPerChunk, 1);
+	FramesInChunk = 0;
+	NumFrames = 0;
+	LastTime = 0.0f;
+	State = FAlphaDemoState();
+	Chunks.Reset();
+	ChunkBuffer.Reset();
+	ChunkBuffer.Reserve(FramesPerChunk * 16);
+
+	uint32 Magic = DemoMagic;
+	uint32 Version = DemoVersion;
+	uint32 ChunkFrames = FramesPerChunk;
+	*FileWriter << Magic << Version << SpeedLimit << ChunkFrames;
+
+	return true;
+}
+
+void FAlphaDemoWriter::AddFrame(const FAlphaDemoFrame& Frame)
+{
+	if (!FileWriter.IsValid())
+		return;
+
+	FAlphaDemoState Next;
+	Next.TimeUnits = FMath::Max(State.TimeUnits, static_cast<uint32>(FMath::RoundToInt(FMath::Max(Frame.Time, 0.0f) / DemoTimeUnit)));
+	Next.Location = QuantizeLocation(Frame.Location);
+	Next.MovementMode = Frame.MovementMode;
+
+	for (int32 Axis = 0; Axis < 3; Axis++)
+		Next.Velocity[Axis] = QuantizeSpeed(Frame.Velocity[Axis], SpeedLimit);
+
+	Next.Rotation[0] = FRotator::CompressAxisToShort(Frame.ControlRotation.Pitch);
+	Next.Rotation[1] = FRotator::CompressAxisToShort(Frame.ControlRotation.Yaw);
+	Next.Rotation[2] = FRotator::CompressAxisToShort(Frame.ControlRotation.Roll);
+
+	if (FramesInChunk == 0)
+	{
+		// key frame, absolute so a chunk decodes without anything before it
+		Chunks.Add({ static_cast<float>(Next.TimeUnits * DemoTimeUnit), static_cast<uint32>(NumFrames), 0 });
+
+		WriteVarUInt(ChunkBuffer, Next.TimeUnits);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarInt(ChunkBuffer, Next.Location[Axis]);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarInt(ChunkBuffer, Next.Velocity[Axis]);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarUInt(ChunkBuffer, Next.Rotation[Axis]);
+
+		ChunkBuffer.Add(Next.MovementMode);
+	}
+	else
+	{
+		const uint32 DeltaUnits = Next.TimeUnits - State.TimeUnits;
+		const FIntVector Predicted = PredictLocation(State, DeltaUnits, SpeedLimit);
+		const bool bModeChanged = Next.MovementMode != State.MovementMode;
+
+		WriteVarUInt(ChunkBuffer, (DeltaUnits << 1) | (bModeChanged ? 1 : 0));
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarInt(ChunkBuffer, Next.Location[Axis] - Predicted[Axis]);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarInt(ChunkBuffer, Next.Velocity[Axis] - State.Velocity[Axis]);
+
+		// wraps, so turning past 180 degrees stays a small delta
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			WriteVarInt(ChunkBuffer, static_cast<int16>(Next.Rotation[Axis] - State.Rotation[Axis]));
+
+		if (bModeChanged)
+			ChunkBuffer.Add(Next.MovementMode);
+	}
+
+	State = Next;
+	LastTime = Frame.Time;
+	FramesInChunk++;
+	NumFrames++;
+
+	if (FramesInChunk >= FramesPerChunk)
+		FlushChunk();
+}
+
+void FAlphaDemoWriter::FlushChunk()
+{
+	if (FramesInChunk == 0)
+		return;
+
+	Chunks.Last().Offset = FileWriter->Tell();
+	FileWriter->Serialize(ChunkBuffer.GetData(), ChunkBuffer.Num());
+
+	ChunkBuffer.Reset();
+	FramesInChunk = 0;
+}
+
+void FAlphaDemoWriter::Close()
+{
+	if (!FileWriter.IsValid())
+		return;
+
+	FlushChunk();
+
+	uint64 IndexOffset = FileWriter->Tell();
+
+	for (FChunkEntry& Entry : Chunks)
+		*FileWriter << Entry.Time << Entry.FirstFrame << Entry.Offset;
+
+	uint32 NumChunks = Chunks.Num();
+	uint32 Frames = NumFrames;
+	float Duration = static_cast<float>(State.TimeUnits * DemoTimeUnit);
+	uint32 Magic = DemoMagic;
+	*FileWriter << IndexOffset << NumChunks << Frames << Duration << Magic;
+
+	FileWriter->Close();
+	FileWriter.Reset();
+	Chunks.Reset();
+}
+
+FAlphaDemoReader::FAlphaDemoReader()
+{
+	Data = nullptr;
+	DataSize = 0;
+	IndexOffset = 0;
+	SpeedLimit = 1.0f;
+	Duration = 0.0f;
+	NumChunks = 0;
+	NumFrames = 0;
+}
+
+FAlphaDemoReader::~FAlphaDemoReader()
+{
+	Close();
+}
+
+bool FAlphaDemoReader::Open(const FString& Filename)
+{
+	Close();
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+
+	if (!MappedFile.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaDemoReader::Open() failed to map %s"), *Filename);
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+
+	if (!MappedRegion.IsValid() || MappedRegion->GetMappedSize() < DemoHeaderSize + DemoFooterSize)
+	{
+		Close();
+		return false;
+	}
+
+	const uint8* Mapped = MappedRegion->GetMappedPtr();
+	const int64 MappedSize = MappedRegion->GetMappedSize();
+	const int64 FooterOffset = MappedSize - DemoFooterSize;
+
+	const uint32 Magic = ReadRaw<uint32>(Mapped, 0);
+	const uint32 Version = ReadRaw<uint32>(Mapped, 4);
+	const uint32 FooterMagic = ReadRaw<uint32>(Mapped, FooterOffset + 20);
+
+	if (Magic != DemoMagic || FooterMagic != DemoMagic || Version != DemoVersion)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaDemoReader::Open() %s is not a version %u demo"), *Filename, DemoVersion);
+		Close();
+		return false;
+	}
+
+	SpeedLimit = ReadRaw<float>(Mapped, 8);
+	IndexOffset = static_cast<int64>(ReadRaw<uint64>(Mapped, FooterOffset));
+	NumChunks = ReadRaw<uint32>(Mapped, FooterOffset + 8);
+	NumFrames = ReadRaw<uint32>(Mapped, FooterOffset + 12);
+	Duration = ReadRaw<float>(Mapped, FooterOffset + 16);
+
+	if (IndexOffset < DemoHeaderSize || IndexOffset + NumChunks * DemoChunkEntrySize > FooterOffset)
+	{
+		UE_LOG(LogTemp, Error, TEXT("FAlphaDemoReader::Open() %s has a corrupt seek index"), *Filename);
+		Close();
+		return false;
+	}
+
+	Data = Mapped;
+	DataSize = MappedSize;
+
+	return true;
+}
+
+void FAlphaDemoReader::Close()
+{
+	// the region has to be released before the file it maps
+	MappedRegion.Reset();
+	MappedFile.Reset();
+
+	Data = nullptr;
+	DataSize = 0;
+	NumChunks = 0;
+	NumFrames = 0;
+	Duration = 0.0f;
+}
+
+void FAlphaDemoReader::ReadChunkEntry(int32 ChunkIndex, float& OutTime, uint32& OutFirstFrame, uint64& OutOffset) const
+{
+	const int64 EntryOffset = IndexOffset + ChunkIndex * DemoChunkEntrySize;
+	OutTime = ReadRaw<float>(Data, EntryOffset);
+	OutFirstFrame = ReadRaw<uint32>(Data, EntryOffset + 4);
+	OutOffset = ReadRaw<uint64>(Data, EntryOffset + 8);
+}
+
+bool FAlphaDemoReader::Seek(float Time, FAlphaDemoCursor& OutCursor) const
+{
+	if (!IsOpen() || NumChunks == 0)
+		return false;
+
+	// last chunk starting at or before the time
+	int32 Low = 0;
+	int32 High = NumChunks - 1;
+
+	while (Low < High)
+	{
+		const int32 Middle = (Low + High + 1) / 2;
+		float ChunkTime;
+		uint32 FirstFrame;
+		uint64 Offset;
+
+		ReadChunkEntry(Middle, ChunkTime, FirstFrame, Offset);
+
+		if (ChunkTime <= Time)
+			Low = Middle;
+		else
+			High = Middle - 1;
+	}
+
+	float ChunkTime;
+	uint32 FirstFrame;
+	uint64 Offset;
+	ReadChunkEntry(Low, ChunkTime, FirstFrame, Offset);
+
+	OutCursor = FAlphaDemoCursor();
+	OutCursor.ChunkIndex = Low;
+	OutCursor.FrameIndex = FirstFrame;
+
+	return true;
+}
+
+bool FAlphaDemoReader::ReadFrame(FAlphaDemoCursor& Cursor, FAlphaDemoFrame& OutFrame) const
+{
+	if (!IsOpen())
+		return false;
+
+	FAlphaDemoState& State = Cursor.State;
+
+	if (Cursor.FramesLeftInChunk == 0)
+	{
+		if (Cursor.ChunkIndex >= NumChunks)
+			return false;
+
+		float ChunkTime;
+		uint32 FirstFrame;
+		uint64 Offset;
+		ReadChunkEntry(Cursor.ChunkIndex, ChunkTime, FirstFrame, Offset);
+
+		uint32 EndFrame = NumFrames;
+
+		if (Cursor.ChunkIndex + 1 < NumChunks)
+		{
+			uint64 NextOffset;
+			ReadChunkEntry(Cursor.ChunkIndex + 1, ChunkTime, EndFrame, NextOffset);
+		}
+
+		Cursor.Offset = Offset;
+		Cursor.ChunkIndex++;
+		Cursor.FrameIndex = FirstFrame;
+		Cursor.FramesLeftInChunk = EndFrame - FirstFrame - 1;
+
+		State.TimeUnits = ReadVarUInt(Data, IndexOffset, Cursor.Offset);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Location[Axis] = ReadVarInt(Data, IndexOffset, Cursor.Offset);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Velocity[Axis] = static_cast<int16>(ReadVarInt(Data, IndexOffset, Cursor.Offset));
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Rotation[Axis] = static_cast<uint16>(ReadVarUInt(Data, IndexOffset, Cursor.Offset));
+
+		State.MovementMode = Cursor.Offset < IndexOffset ? Data[Cursor.Offset++] : 0;
+	}
+	else
+	{
+		const uint32 Header = ReadVarUInt(Data, IndexOffset, Cursor.Offset);
+		const uint32 DeltaUnits = Header >> 1;
+		const FIntVector Predicted = PredictLocation(State, DeltaUnits, SpeedLimit);
+
+		State.TimeUnits += DeltaUnits;
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Location[Axis] = Predicted[Axis] + ReadVarInt(Data, IndexOffset, Cursor.Offset);
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Velocity[Axis] = static_cast<int16>(State.Velocity[Axis] + ReadVarInt(Data, IndexOffset, Cursor.Offset));
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+			State.Rotation[Axis] = static_cast<uint16>(State.Rotation[Axis] + ReadVarInt(Data, IndexOffset, Cursor.Offset));
+
+		if ((Header & 1) && Cursor.Offset < IndexOffset)
+			State.MovementMode = Data[Cursor.Offset++];
+
+		Cursor.FramesLeftInChunk--;
+		Cursor.FrameIndex++;
+	}
+
+	DecodeState(State, SpeedLimit, OutFrame);
+	return true;
+}
+
+bool FAlphaDemoReader::Sample(float Time, FAlphaDemoFrame& OutFrame) const
+{
+	FAlphaDemoCursor Cursor;
+	FAlphaDemoFrame Previous;
+
+	if (!Seek(Time, Cursor) || !ReadFrame(Cursor, Previous))
+		return false;
+
+	FAlphaDemoFrame Next;
+
+	while (ReadFrame(Cursor, Next))
+	{
+		if (Next.Time >= Time)
+		{
+			const float Span = Next.Time - Previous.Time;
+			OutFrame = FAlphaDemoFrame::Lerp(Previous, Next, Span > KINDA_SMALL_NUMBER ? (Time - Previous.Time) / Span : 1.0f);
+			return true;
+		}
+
+		Previous = Next;
+	}
+
+	OutFrame = Previous;
+	return true;
+}
+
+static UAlphaMovementConfig* GetLocalAlphaMovement(UWorld* World)
+{
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	return Pawn ? Cast<UAlphaMovementConfig>(Pawn->GetMovementComponent()) : nullptr;
+}
+
+static FAutoConsoleCommandWithWorldAndArgs AlphaDemoRecordCommand(
+	TEXT("alpha.Demo.Record"),
+	TEXT("Records the local character's movement to Saved/Demos/<Name>.alphademo"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		UAlphaMovementConfig* Movement = GetLocalAlphaMovement(World);
+
+		if (Movement == nullptr)
+			return;
+
+		const FString Name = Args.Num() > 0 ? Args[0] : FDateTime::Now().ToString();
+		Movement->StartDemoRecording(FPaths::ProjectSavedDir() / TEXT("Demos") / Name + TEXT(".alphademo"));
+	})
+);
+
+static FAutoConsoleCommandWithWorldAndArgs AlphaDemoStopCommand(
+	TEXT("alpha.Demo.Stop"),
+	TEXT("Stops recording the local character's movement"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UAlphaMovementConfig* Movement = GetLocalAlphaMovement(World))
+			Movement->StopDemoRecording();
+	})
+);
@@ -0,0 +1,165 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Movement state recorded after a movement tick
+ */
+struct FAlphaDemoFrame
+{
+	/**
+	 * Seconds since the recording started
+	 */
+	float Time = 0.0f;
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FRotator ControlRotation = FRotator::ZeroRotator;
+	uint8 MovementMode = 0;
+
+	/**
+	 * Blends two frames, movement mode is taken from the closest one
+	 */
+	static FAlphaDemoFrame Lerp(const FAlphaDemoFrame& A, const FAlphaDemoFrame& B, float Alpha);
+};
+
+/**
+ * Quantized frame state, the encoder and decoder both step this so they reconstruct identical frames
+ */
+struct FAlphaDemoState
+{
+	uint32 TimeUnits = 0;
+	FIntVector Location = FIntVector::ZeroValue;
+	int16 Velocity[3] = { 0, 0, 0 };
+	uint16 Rotation[3] = { 0, 0, 0 };
+	uint8 MovementMode = 0;
+};
+
+/**
+ * Position of a decoder inside a demo, decoding a frame only touches the mapped file and this struct
+ */
+struct FAlphaDemoCursor
+{
+	FAlphaDemoState State;
+	int64 Offset = 0;
+	int32 ChunkIndex = 0;
+	int32 FrameIndex = 0;
+	int32 FramesLeftInChunk = 0;
+};
+
+/**
+ * Writes a demo file.
+ *
+ * Layout: header, chunks, seek index, footer. Each chunk starts with an absolute key frame followed by frames
+ * delta encoded against the previous one. Velocity is quantized to 16 bits against AxisSpeedLimit and position
+ * is stored as the error from extrapolating the previous position with the previous velocity, so most axes
+ * take a single byte per frame.
+ */
+class FAlphaDemoWriter
+{
+public:
+	FAlphaDemoWriter();
+	~FAlphaDemoWriter();
+
+	/**
+	 * Creates the file and writes the header
+	 * @param AxisSpeedLimit Max speed on any axis, velocity is quantized against it
+	 * @param FramesPerChunk Frames between key frames, smaller chunks seek faster but compress worse
+	 */
+	bool Open(const FString& Filename, float AxisSpeedLimit, int32 FramesPerChunk = 256);
+
+	void AddFrame(const FAlphaDemoFrame& Frame);
+
+	/**
+	 * Flushes the last chunk and writes the seek index
+	 */
+	void Close();
+
+	bool IsOpen() const
+	{
+		return FileWriter.IsValid();
+	}
+
+	int32 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+private:
+	struct FChunkEntry
+	{
+		float Time;
+		uint32 FirstFrame;
+		uint64 Offset;
+	};
+
+	void FlushChunk();
+
+	TUniquePtr<FArchive> FileWriter;
+	TArray<uint8> ChunkBuffer;
+	TArray<FChunkEntry> Chunks;
+	FAlphaDemoState State;
+	float SpeedLimit;
+	float LastTime;
+	int32 FramesPerChunk;
+	int32 FramesInChunk;
+	int32 NumFrames;
+};
+
+/**
+ * Reads a demo file through a memory mapping, only the pages being decoded are resident
+ */
+class FAlphaDemoReader
+{
+public:
+	FAlphaDemoReader();
+	~FAlphaDemoReader();
+
+	bool Open(const FString& Filename);
+	void Close();
+
+	bool IsOpen() const
+	{
+		return Data != nullptr;
+	}
+
+	int32 GetNumFrames() const
+	{
+		return NumFrames;
+	}
+
+	float GetDuration() const
+	{
+		return Duration;
+	}
+
+	/**
+	 * Positions a cursor on the key frame of the chunk containing the given time
+	 */
+	bool Seek(float Time, FAlphaDemoCursor& OutCursor) const;
+
+	/**
+	 * Decodes the frame under the cursor and advances it
+	 * @return False once the end of the demo is reached
+	 */
+	bool ReadFrame(FAlphaDemoCursor& Cursor, FAlphaDemoFrame& OutFrame) const;
+
+	/**
+	 * Seeks and interpolates the state at the given time, use a cursor when playing back continuously
+	 */
+	bool Sample(float Time, FAlphaDemoFrame& OutFrame) const;
+
+private:
+	void ReadChunkEntry(int32 ChunkIndex, float& OutTime, uint32& OutFirstFrame, uint64& OutOffset) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data;
+	int64 DataSize;
+	int64 IndexOffset;
+	float SpeedLimit;
+	float Duration;
+	int32 NumChunks;
+	int32 NumFrames;
+};
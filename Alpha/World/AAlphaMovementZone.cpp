@@ -0,0 +1,30 @@
+#include "AAlphaMovementZone.h"
+#include "UAlphaMovementZoneSubsystem.h"
+#include "Components/BrushComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/World.h"
+
+AAlphaMovementZone::AAlphaMovementZone()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// looked up through the zone subsystem, no overlap events
+	GetBrushComponent()->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	GetBrushComponent()->SetGenerateOverlapEvents(false);
+}
+
+void AAlphaMovementZone::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UAlphaMovementZoneSubsystem* Zones = GetWorld()->GetSubsystem<UAlphaMovementZoneSubsystem>())
+		Zones->RegisterZone(this);
+}
+
+void AAlphaMovementZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UAlphaMovementZoneSubsystem* Zones = GetWorld()->GetSubsystem<UAlphaMovementZoneSubsystem>())
+		Zones->UnregisterZone(this);
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "GameFramework/Volume.h"
+#include "AAlphaMovementZone.generated.h"
+
+/**
+ * Movement values a zone replaces while a character is inside it
+ */
+USTRUCT(BlueprintType)
+struct FAlphaMovementZoneSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (InlineEditConditionToggle))
+	bool bOverrideGravityZ = false;
+
+	/**
+	 * Gravity replacing the world's, scaled by each character's GravityScale like a physics volume's
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (EditCondition = "bOverrideGravityZ"))
+	float GravityZ = -980.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (InlineEditConditionToggle))
+	bool bOverrideSurfaceFriction = false;
+
+	/**
+	 * Surface friction while on the ground, 0 is frictionless
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (EditCondition = "bOverrideSurfaceFriction", ClampMin = "0", UIMin = "0", UIMax = "1"))
+	float SurfaceFriction = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (InlineEditConditionToggle))
+	bool bOverrideAirAcceleration = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (EditCondition = "bOverrideAirAcceleration", ClampMin = "0", UIMin = "0"))
+	float AirAccelerationModifier = 10.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (InlineEditConditionToggle))
+	bool bOverrideAirSpeedCap = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (EditCondition = "bOverrideAirSpeedCap", ClampMin = "0", UIMin = "0"))
+	float AirSpeedCap = 57.15f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (InlineEditConditionToggle))
+	bool bOverrideMaxSpeed = false;
+
+	/**
+	 * Max ground speed (unit/s)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (EditCondition = "bOverrideMaxSpeed", ClampMin = "0", UIMin = "0"))
+	float MaxSpeed = 609.6f;
+};
+
+/**
+ * Volume overriding gravity, friction, air acceleration and speed caps for characters inside it.
+ *
+ * Zones have no collision and don't tick, UAlphaMovementZoneSubsystem bakes them into a spatial hash when they begin
+ * play and movement components look themselves up once per update. A zone is tested as its oriented bounding box and
+ * is expected to stay where it was placed.
+ */
+UCLASS()
+class AAlphaMovementZone : public AVolume
+{
+	GENERATED_BODY()
+
+public:
+	AAlphaMovementZone();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * Overlapping zones with a higher priority win
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone")
+	int32 Priority = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement Zone", meta = (ShowOnlyInnerProperties))
+	FAlphaMovementZoneSettings Settings;
+};
@@ -0,0 +1,246 @@
+#include "FAlphaRampWelder.h"
+
+static uint64 MakeEdgeKey(int32 A, int32 B)
+{
+	return (static_cast<uint64>(FMath::Min(A, B)) << 32) | static_cast<uint32>(FMath::Max(A, B));
+}
+
+void FAlphaRampWelder::AddTriangles(TConstArrayView<FVector3f> InPositions, TConstArrayView<uint32> InIndices, const FTransform& Transform, int32 SourceId, int32 MaterialId)
+{
+	const int32 BaseIndex = Positions.Num();
+	Positions.Reserve(BaseIndex + InPositions.Num());
+
+	for (const FVector3f& Position : InPositions)
+		Positions.Add(Transform.TransformPosition(FVector(Position)));
+
+	// mirrored transforms flip the winding
+	const bool bFlip = Transform.GetDeterminant() < 0.0f;
+
+	for (int32 Index = 0; Index + 2 < InIndices.Num(); Index += 3)
+	{
+		Indices.Add(BaseIndex + InIndices[Index]);
+		Indices.Add(BaseIndex + InIndices[bFlip ? Index + 2 : Index + 1]);
+		Indices.Add(BaseIndex + InIndices[bFlip ? Index + 1 : Index + 2]);
+		Sources.Add(SourceId);
+		Materials.Add(MaterialId);
+	}
+}
+
+FAlphaRampWeldResult FAlphaRampWelder::Weld(const FAlphaRampWeldParams& Params) const
+{
+	FAlphaRampWeldResult Result;
+	Result.NumInputTriangles = Sources.Num();
+
+	const float WeldDistance = FMath::Max(Params.WeldDistance, KINDA_SMALL_NUMBER);
+	const float WeldDistanceSq = WeldDistance * WeldDistance;
+
+	// merge vertices through a hash of WeldDistance sized cells, checking the neighbouring cells too
+	TMap<FIntVector, TArray<int32>> Cells;
+	TArray<int32> Welded;
+	Welded.SetNumUninitialized(Positions.Num());
+
+	for (int32 Vertex = 0; Vertex < Positions.Num(); Vertex++)
+	{
+		const FVector& Position = Positions[Vertex];
+		const FIntVector Cell(FMath::FloorToInt(Position.X / WeldDistance), FMath::FloorToInt(Position.Y / WeldDistance), FMath::FloorToInt(Position.Z / WeldDistance));
+		int32 Match = INDEX_NONE;
+
+		for (int32 X = -1; X <= 1 && Match == INDEX_NONE; X++)
+		{
+			for (int32 Y = -1; Y <= 1 && Match == INDEX_NONE; Y++)
+			{
+				for (int32 Z = -1; Z <= 1 && Match == INDEX_NONE; Z++)
+				{
+					const TArray<int32>* Candidates = Cells.Find(Cell + FIntVector(X, Y, Z));
+
+					if (Candidates == nullptr)
+						continue;
+
+					for (const int32 Candidate : *Candidates)
+					{
+						if (FVector::DistSquared(Result.Vertices[Candidate], Position) <= WeldDistanceSq)
+						{
+							Match = Candidate;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (Match == INDEX_NONE)
+		{
+			Match = Result.Vertices.Add(Position);
+			Cells.FindOrAdd(Cell).Add(Match);
+		}
+
+		Welded[Vertex] = Match;
+	}
+
+	// triangles collapsed by the weld are dropped
+	TArray<int32> Triangles;
+	TArray<FVector> Normals;
+	TArray<float> Areas;
+
+	for (int32 Triangle = 0; Triangle < Sources.Num(); Triangle++)
+	{
+		const int32 A = Welded[Indices[Triangle * 3]];
+		const int32 B = Welded[Indices[Triangle * 3 + 1]];
+		const int32 C = Welded[Indices[Triangle * 3 + 2]];
+
+		if (A == B || B == C || C == A)
+			continue;
+
+		const FVector Cross = FVector::CrossProduct(Result.Vertices[B] - Result.Vertices[A], Result.Vertices[C] - Result.Vertices[A]);
+		const float Area = 0.5f * Cross.Size();
+
+		if (Area <= KINDA_SMALL_NUMBER)
+			continue;
+
+		Triangles.Add(Triangle);
+		Normals.Add(Cross / (2.0f * Area));
+		Areas.Add(Area);
+	}
+
+	auto GetEdge = [this, &Welded, &Triangles](int32 Index, int32 Corner)
+	{
+		const int32 Triangle = Triangles[Index];
+		return MakeEdgeKey(Welded[Indices[Triangle * 3 + Corner]], Welded[Indices[Triangle * 3 + (Corner + 1) % 3]]);
+	};
+
+	TMultiMap<uint64, int32> EdgeTriangles;
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		for (int32 Corner = 0; Corner < 3; Corner++)
+			EdgeTriangles.Add(GetEdge(Index, Corner), Index);
+	}
+
+	// grow planes across shared edges, every triangle is compared with the plane's first one so small bends along a
+	// curved ramp can't chain into a single plane
+	const float MinNormalDot = FMath::Cos(FMath::DegreesToRadians(Params.MaxSeamAngle));
+	TSet<uint64> SeamPairs;
+	TArray<int32> Roots;
+	Roots.Init(INDEX_NONE, Triangles.Num());
+	TArray<int32> Open;
+	TArray<int32> Neighbours;
+
+	for (int32 Seed = 0; Seed < Triangles.Num(); Seed++)
+	{
+		if (Roots[Seed] != INDEX_NONE)
+			continue;
+
+		Roots[Seed] = Seed;
+		Open.Reset();
+		Open.Add(Seed);
+
+		while (Open.Num() > 0)
+		{
+			const int32 Index = Open.Pop(EAllowShrinking::No);
+
+			for (int32 Corner = 0; Corner < 3; Corner++)
+			{
+				Neighbours.Reset();
+				EdgeTriangles.MultiFind(GetEdge(Index, Corner), Neighbours);
+
+				for (const int32 Neighbour : Neighbours)
+				{
+					if (Roots[Neighbour] != INDEX_NONE || (Normals[Neighbour] | Normals[Seed]) < MinNormalDot)
+						continue;
+
+					Roots[Neighbour] = Seed;
+					Open.Add(Neighbour);
+
+					const int32 Source = Sources[Triangles[Index]];
+					const int32 NeighbourSource = Sources[Triangles[Neighbour]];
+
+					if (Source != NeighbourSource)
+						SeamPairs.Add(MakeEdgeKey(Source, NeighbourSource));
+				}
+			}
+		}
+	}
+
+	// best fit plane of every group, and which sources each group spans
+	struct FSurface
+	{
+		FVector Normal = FVector::ZeroVector;
+		FVector Centroid = FVector::ZeroVector;
+		float Area = 0.0f;
+		int32 FirstSource = INDEX_NONE;
+		bool bMerged = false;
+	};
+
+	TMap<int32, FSurface> Surfaces;
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		const int32 Triangle = Triangles[Index];
+		const int32 Source = Sources[Triangle];
+		FSurface& Surface = Surfaces.FindOrAdd(Roots[Index]);
+
+		const FVector Centroid = (Result.Vertices[Welded[Indices[Triangle * 3]]] + Result.Vertices[Welded[Indices[Triangle * 3 + 1]]] + Result.Vertices[Welded[Indices[Triangle * 3 + 2]]]) / 3.0f;
+		Surface.Normal += Normals[Index] * Areas[Index];
+		Surface.Centroid += Centroid * Areas[Index];
+		Surface.Area += Areas[Index];
+
+		if (Surface.FirstSource == INDEX_NONE)
+		{
+			Surface.FirstSource = Source;
+		}
+		else if (Surface.FirstSource != Source)
+		{
+			Surface.bMerged = true;
+		}
+	}
+
+	// a vertex on several merged surfaces goes to the largest, the others only lose a sliver at their border
+	TArray<int32> VertexSurfaces;
+	VertexSurfaces.Init(INDEX_NONE, Result.Vertices.Num());
+
+	for (int32 Index = 0; Index < Triangles.Num(); Index++)
+	{
+		const int32 Root = Roots[Index];
+		const FSurface& Surface = Surfaces[Root];
+
+		if (!Surface.bMerged)
+			continue;
+
+		for (int32 Corner = 0; Corner < 3; Corner++)
+		{
+			int32& VertexSurface = VertexSurfaces[Welded[Indices[Triangles[Index] * 3 + Corner]]];
+
+			if (VertexSurface == INDEX_NONE || Surfaces[VertexSurface].Area < Surface.Area)
+				VertexSurface = Root;
+		}
+	}
+
+	for (int32 Vertex = 0; Vertex < Result.Vertices.Num(); Vertex++)
+	{
+		if (VertexSurfaces[Vertex] == INDEX_NONE)
+			continue;
+
+		const FSurface& Surface = Surfaces[VertexSurfaces[Vertex]];
+		const FVector Normal = Surface.Normal.GetSafeNormal();
+		const FVector Centroid = Surface.Centroid / Surface.Area;
+
+		Result.Vertices[Vertex] -= Normal * ((Result.Vertices[Vertex] - Centroid) | Normal);
+	}
+
+	Result.Indices.Reserve(Triangles.Num() * 3);
+	Result.Materials.Reserve(Triangles.Num());
+
+	for (const int32 Triangle : Triangles)
+	{
+		for (int32 Corner = 0; Corner < 3; Corner++)
+			Result.Indices.Add(Welded[Indices[Triangle * 3 + Corner]]);
+
+		Result.Materials.Add(Materials[Triangle]);
+	}
+
+	for (const TPair<int32, FSurface>& Surface : Surfaces)
+		Result.NumMergedSurfaces += Surface.Value.bMerged;
+
+	Result.NumSeamsRemoved = SeamPairs.Num();
+	return Result;
+}
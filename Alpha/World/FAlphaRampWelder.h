@@ -0,0 +1,81 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * Tolerances deciding which ramp triangles are one surface
+ */
+struct FAlphaRampWeldParams
+{
+	/**
+	 * Vertices closer than this (in units) become one vertex
+	 */
+	float WeldDistance = 1.0f;
+
+	/**
+	 * Max angle (deg) between a triangle and the first triangle of a plane for it to be merged into that plane, so
+	 * a curved ramp splits into planes no more than this apart instead of flattening into one
+	 */
+	float MaxSeamAngle = 1.0f;
+};
+
+/**
+ * Welded collision of every triangle added to a FAlphaRampWelder
+ */
+struct FAlphaRampWeldResult
+{
+	TArray<FVector> Vertices;
+	TArray<int32> Indices;
+
+	/**
+	 * Material id of every triangle in Indices, as passed to AddTriangles
+	 */
+	TArray<int32> Materials;
+
+	int32 NumInputTriangles = 0;
+
+	/**
+	 * Planes which merged triangles from more than one source mesh
+	 */
+	int32 NumMergedSurfaces = 0;
+
+	/**
+	 * Distinct pairs of source meshes whose touching surfaces were merged into one plane
+	 */
+	int32 NumSeamsRemoved = 0;
+};
+
+/**
+ * Welds the seams between surf ramp meshes into continuous collision.
+ *
+ * Ramps built from several meshes meet at seams which are never exactly flush, a fraction of a unit of height or
+ * angle between pieces gives the capsule a contact with a bogus normal at surf speeds. The welder merges nearby
+ * vertices, grows planes out of edge-connected triangles within a tolerance of each plane's first triangle, and
+ * snaps every vertex of a plane spanning several meshes onto its best fit plane, so the surface has one normal.
+ */
+class FAlphaRampWelder
+{
+public:
+	/**
+	 * Adds a mesh's triangles in world space
+	 * @param SourceId Mesh the triangles come from, seams are only counted between different sources
+	 * @param MaterialId Carried through to the welded triangles, so they keep the surface they came from
+	 */
+	void AddTriangles(TConstArrayView<FVector3f> Positions, TConstArrayView<uint32> Indices, const FTransform& Transform, int32 SourceId, int32 MaterialId = 0);
+
+	FAlphaRampWeldResult Weld(const FAlphaRampWeldParams& Params) const;
+
+	int32 GetNumTriangles() const
+	{
+		return Sources.Num();
+	}
+
+private:
+	TArray<FVector> Positions;
+	TArray<int32> Indices;
+
+	/**
+	 * Source and material of every triangle
+	 */
+	TArray<int32> Sources;
+	TArray<int32> Materials;
+};
@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+#include "Alpha/World/FAlphaRampWelder.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// a strip bending up by this much (deg) per segment, a fraction of the default seam angle so planes of four segments
+// form and one of them crosses the seam halfway
+const float CURVE_STEP_ANGLE = 0.3f;
+const int32 CURVE_SEGMENTS = 20;
+const float CURVE_RADIUS = 1000.0f;
+const float STRIP_WIDTH = 100.0f;
+
+/**
+ * Adds segments [First, Last) of a strip curving up along X as one source mesh
+ */
+static void AddCurvedStrip(FAlphaRampWelder& Welder, int32 First, int32 Last, int32 SourceId)
+{
+	TArray<FVector3f> Positions;
+	TArray<uint32> Indices;
+
+	for (int32 Segment = First; Segment <= Last; Segment++)
+	{
+		const float Angle = FMath::DegreesToRadians(Segment * CURVE_STEP_ANGLE);
+		const float X = CURVE_RADIUS * FMath::Sin(Angle);
+		const float Z = CURVE_RADIUS * (1.0f - FMath::Cos(Angle));
+
+		Positions.Add(FVector3f(X, 0.0f, Z));
+		Positions.Add(FVector3f(X, STRIP_WIDTH, Z));
+	}
+
+	for (uint32 Segment = 0; Segment < static_cast<uint32>(Last - First); Segment++)
+	{
+		const uint32 Base = Segment * 2;
+		Indices.Append({ Base, Base + 1, Base + 2, Base + 1, Base + 3, Base + 2 });
+	}
+
+	Welder.AddTriangles(Positions, Indices, FTransform::Identity, SourceId);
+}
+
+static FVector GetTriangleNormal(const FAlphaRampWeldResult& Result, int32 Triangle)
+{
+	const FVector& A = Result.Vertices[Result.Indices[Triangle * 3]];
+	const FVector& B = Result.Vertices[Result.Indices[Triangle * 3 + 1]];
+	const FVector& C = Result.Vertices[Result.Indices[Triangle * 3 + 2]];
+	return FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlphaRampWelderCurveTest, "Alpha.World.RampWelder.CurvedStrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAlphaRampWelderCurveTest::RunTest(const FString& Parameters)
+{
+	// two pieces meeting halfway, so the planes crossing the seam get snapped
+	FAlphaRampWelder Welder;
+	AddCurvedStrip(Welder, 0, CURVE_SEGMENTS / 2, 0);
+	AddCurvedStrip(Welder, CURVE_SEGMENTS / 2, CURVE_SEGMENTS, 1);
+
+	const FAlphaRampWeldResult Result = Welder.Weld(FAlphaRampWeldParams());
+	const int32 NumTriangles = Result.Indices.Num() / 3;
+
+	TestEqual(TEXT("Triangles"), NumTriangles, CURVE_SEGMENTS * 2);
+	TestEqual(TEXT("Seams removed"), Result.NumSeamsRemoved, 1);
+
+	// every segment bends less than the seam angle, chaining them would flatten the whole strip onto one plane
+	const float TotalAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(GetTriangleNormal(Result, 0) | GetTriangleNormal(Result, NumTriangles - 1), -1.0f, 1.0f)));
+	TestTrue(TEXT("Curve kept"), TotalAngle > (CURVE_SEGMENTS - 1) * CURVE_STEP_ANGLE - 2.0f * FAlphaRampWeldParams().MaxSeamAngle);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAlphaRampWelderFlatSeamTest, "Alpha.World.RampWelder.FlatSeam", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FAlphaRampWelderFlatSeamTest::RunTest(const FString& Parameters)
+{
+	// two flat pieces with the second raised a fraction of a unit at the seam, the weld has to make them one plane
+	const TArray<FVector3f> First = { FVector3f(0.0f, 0.0f, 0.0f), FVector3f(0.0f, 100.0f, 0.0f), FVector3f(100.0f, 0.0f, 0.0f), FVector3f(100.0f, 100.0f, 0.0f) };
+	const TArray<FVector3f> Second = { FVector3f(100.0f, 0.0f, 0.2f), FVector3f(100.0f, 100.0f, 0.2f), FVector3f(200.0f, 0.0f, 0.2f), FVector3f(200.0f, 100.0f, 0.2f) };
+	const TArray<uint32> Indices = { 0, 1, 2, 1, 3, 2 };
+
+	FAlphaRampWelder Welder;
+	Welder.AddTriangles(First, Indices, FTransform::Identity, 0, 0);
+	Welder.AddTriangles(Second, Indices, FTransform::Identity, 1, 1);
+
+	const FAlphaRampWeldResult Result = Welder.Weld(FAlphaRampWeldParams());
+	const FVector Normal = GetTriangleNormal(Result, 0);
+
+	TestEqual(TEXT("Merged surfaces"), Result.NumMergedSurfaces, 1);
+
+	for (int32 Triangle = 1; Triangle < Result.Indices.Num() / 3; Triangle++)
+		TestTrue(TEXT("One normal"), (GetTriangleNormal(Result, Triangle) | Normal) > 1.0f - KINDA_SMALL_NUMBER);
+
+	// each piece keeps its material through the weld
+	TestTrue(TEXT("Materials"), Result.Materials == TArray<int32>({ 0, 0, 1, 1 }));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "UAlphaMovementZoneSubsystem.h"
+#include "Components/BrushComponent.h"
+
+void UAlphaMovementZoneSubsystem::RegisterZone(AAlphaMovementZone* Zone)
+{
+	Zones.AddUnique(Zone);
+	bDirty = true;
+}
+
+void UAlphaMovementZoneSubsystem::UnregisterZone(AAlphaMovementZone* Zone)
+{
+	if (Zones.Remove(Zone) > 0)
+		bDirty = true;
+}
+
+FIntVector UAlphaMovementZoneSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UAlphaMovementZoneSubsystem::Rebuild()
+{
+	bDirty = false;
+	Entries.Reset();
+	Cells.Reset();
+
+	for (const AAlphaMovementZone* Zone : Zones)
+	{
+		if (!IsValid(Zone))
+			continue;
+
+		const UBrushComponent* Brush = Zone->GetBrushComponent();
+
+		FZoneEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Transform = Brush->GetComponentTransform();
+		Entry.LocalBounds = Brush->CalcBounds(FTransform::Identity).GetBox();
+		Entry.Priority = Zone->Priority;
+		Entry.Settings = Zone->Settings;
+	}
+
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		const FBox WorldBounds = Entries[Index].LocalBounds.TransformBy(Entries[Index].Transform);
+		const FIntVector Min = GetCell(WorldBounds.Min);
+		const FIntVector Max = GetCell(WorldBounds.Max);
+
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+			{
+				for (int32 Z = Min.Z; Z <= Max.Z; Z++)
+					Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Index);
+			}
+		}
+	}
+
+	// lookups take the first zone containing the location
+	for (TPair<FIntVector, TArray<int32>>& Cell : Cells)
+	{
+		Cell.Value.Sort([this](int32 A, int32 B)
+		{
+			return Entries[A].Priority > Entries[B].Priority;
+		});
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UAlphaMovementZoneSubsystem baked %d zones into %d cells"), Entries.Num(), Cells.Num());
+}
+
+bool UAlphaMovementZoneSubsystem::FindZone(const FVector& Location, FAlphaMovementZoneSettings& OutSettings)
+{
+	if (bDirty)
+		Rebuild();
+
+	const TArray<int32>* Cell = Cells.Find(GetCell(Location));
+
+	if (Cell == nullptr)
+		return false;
+
+	for (const int32 Index : *Cell)
+	{
+		const FZoneEntry& Entry = Entries[Index];
+
+		if (Entry.LocalBounds.IsInsideOrOn(Entry.Transform.InverseTransformPosition(Location)))
+		{
+			OutSettings = Entry.Settings;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "Subsystems/WorldSubsystem.h"
+#include "AAlphaMovementZone.h"
+#include "UAlphaMovementZoneSubsystem.generated.h"
+
+/**
+ * Spatial hash of the world's AAlphaMovementZone volumes.
+ *
+ * Every cell lists the zones whose bounds touch it, highest priority first, so finding the zone at a location is one
+ * hash lookup and a box test for each zone in that cell. The hash is rebuilt on the next lookup after zones are added
+ * or removed, which normally only happens while the map loads.
+ */
+UCLASS()
+class UAlphaMovementZoneSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterZone(AAlphaMovementZone* Zone);
+	void UnregisterZone(AAlphaMovementZone* Zone);
+
+	/**
+	 * Finds the settings of the highest priority zone containing a location
+	 * @return False if the location is outside every zone
+	 */
+	bool FindZone(const FVector& Location, FAlphaMovementZoneSettings& OutSettings);
+
+	int32 GetNumZones() const
+	{
+		return Zones.Num();
+	}
+
+	/**
+	 * Size (in units) of a hash cell
+	 */
+	float CellSize = 2048.0f;
+
+private:
+	struct FZoneEntry
+	{
+		FTransform Transform;
+		FBox LocalBounds;
+		int32 Priority;
+		FAlphaMovementZoneSettings Settings;
+	};
+
+	void Rebuild();
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	UPROPERTY()
+	TArray<AAlphaMovementZone*> Zones;
+
+	TArray<FZoneEntry> Entries;
+	TMap<FIntVector, TArray<int32>> Cells;
+	bool bDirty = false;
+};
@@ -0,0 +1,260 @@
+#include "UAlphaRampWeldCommandlet.h"
+#include "FAlphaRampWelder.h"
+#include "Alpha/LoadTest/FAlphaBenchmarkMapGenerator.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Misc/PackageName.h"
+#include "Misc/Parse.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "StaticMeshAttributes.h"
+#include "StaticMeshResources.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+const FName UAlphaRampWeldCommandlet::WeldedRampTag(TEXT("WeldedSurfRamp"));
+
+UAlphaRampWeldCommandlet::UAlphaRampWeldCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+#if WITH_EDITOR
+/**
+ * Surface the welded triangles take over from a ramp section, the material and the body's physical material override
+ */
+using FAlphaRampSurface = TPair<UMaterialInterface*, UPhysicalMaterial*>;
+
+static bool AddRampTriangles(FAlphaRampWelder& Welder, const AStaticMeshActor* Ramp, int32 SourceId, TArray<FAlphaRampSurface>& Surfaces)
+{
+	const UStaticMeshComponent* Component = Ramp->GetStaticMeshComponent();
+	const UStaticMesh* Mesh = Component->GetStaticMesh();
+	const FStaticMeshRenderData* RenderData = Mesh ? Mesh->GetRenderData() : nullptr;
+
+	if (RenderData == nullptr || RenderData->LODResources.Num() == 0)
+		return false;
+
+	// the render mesh splits vertices along hard edges, the weld joins them again
+	const FStaticMeshLODResources& LOD = RenderData->LODResources[0];
+	const FPositionVertexBuffer& PositionBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+
+	TArray<FVector3f> Positions;
+	Positions.SetNumUninitialized(PositionBuffer.GetNumVertices());
+
+	for (uint32 Vertex = 0; Vertex < PositionBuffer.GetNumVertices(); Vertex++)
+		Positions[Vertex] = PositionBuffer.VertexPosition(Vertex);
+
+	TArray<uint32> Indices;
+	LOD.IndexBuffer.GetCopy(Indices);
+
+	// one surface per section, so the welded collision keeps each piece's friction
+	UPhysicalMaterial* PhysMaterialOverride = Component->BodyInstance.GetPhysMaterialOverride();
+
+	for (const FStaticMeshSection& Section : LOD.Sections)
+	{
+		const int32 MaterialId = Surfaces.AddUnique(FAlphaRampSurface(Component->GetMaterial(Section.MaterialIndex), PhysMaterialOverride));
+		const TConstArrayView<uint32> SectionIndices(Indices.GetData() + Section.FirstIndex, Section.NumTriangles * 3);
+		Welder.AddTriangles(Positions, SectionIndices, Component->GetComponentTransform(), SourceId, MaterialId);
+	}
+
+	return true;
+}
+
+/**
+ * Material for each surface, a ramp's physical material override goes into an instance since the welded mesh
+ * uses one body for every piece
+ */
+static TArray<UMaterialInterface*> MakeSurfaceMaterials(UPackage* Package, const TArray<FAlphaRampSurface>& Surfaces)
+{
+	TArray<UMaterialInterface*> Materials;
+	Materials.Reserve(Surfaces.Num());
+
+	for (const FAlphaRampSurface& Surface : Surfaces)
+	{
+		if (Surface.Value == nullptr)
+		{
+			Materials.Add(Surface.Key);
+			continue;
+		}
+
+		const FName InstanceName = MakeUniqueObjectName(Package, UMaterialInstanceConstant::StaticClass(), TEXT("WeldedSurfRampMaterial"));
+		UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(Package, InstanceName, RF_Public);
+		Instance->SetParentEditorOnly(Surface.Key ? Surface.Key : UMaterial::GetDefaultMaterial(MD_Surface));
+		Instance->PhysMaterial = Surface.Value;
+		Instance->PostEditChange();
+		Materials.Add(Instance);
+	}
+
+	return Materials;
+}
+
+static UStaticMesh* BuildWeldedMesh(UPackage* Package, const FAlphaRampWeldResult& Result, const TArray<UMaterialInterface*>& Materials, const FVector& Origin)
+{
+	FMeshDescription MeshDescription;
+	FStaticMeshAttributes Attributes(MeshDescription);
+	Attributes.Register();
+
+	TArray<FVertexID> VertexIDs;
+	VertexIDs.Reserve(Result.Vertices.Num());
+
+	for (const FVector& Vertex : Result.Vertices)
+	{
+		const FVertexID VertexID = MeshDescription.CreateVertex();
+		Attributes.GetVertexPositions()[VertexID] = FVector3f(Vertex - Origin);
+		VertexIDs.Add(VertexID);
+	}
+
+	const FName MeshName = MakeUniqueObjectName(Package, UStaticMesh::StaticClass(), TEXT("WeldedSurfRamps"));
+	UStaticMesh* Mesh = NewObject<UStaticMesh>(Package, MeshName, RF_Public);
+
+	// a polygon group per surface, complex collision hits return the physical material of the face's section
+	TArray<FPolygonGroupID> PolygonGroups;
+
+	for (int32 MaterialId = 0; MaterialId < Materials.Num(); MaterialId++)
+	{
+		const FName SlotName(TEXT("Surface"), MaterialId);
+		const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+		Attributes.GetPolygonGroupMaterialSlotNames()[PolygonGroup] = SlotName;
+		Mesh->GetStaticMaterials().Add(FStaticMaterial(Materials[MaterialId], SlotName, SlotName));
+		PolygonGroups.Add(PolygonGroup);
+	}
+
+	for (int32 Index = 0; Index + 2 < Result.Indices.Num(); Index += 3)
+	{
+		const FVertexInstanceID Corners[3] = {
+			MeshDescription.CreateVertexInstance(VertexIDs[Result.Indices[Index]]),
+			MeshDescription.CreateVertexInstance(VertexIDs[Result.Indices[Index + 1]]),
+			MeshDescription.CreateVertexInstance(VertexIDs[Result.Indices[Index + 2]])
+		};
+
+		MeshDescription.CreateTriangle(PolygonGroups[Result.Materials[Index / 3]], Corners);
+	}
+
+	// collision only, the triangles themselves are the collision
+	UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+	BuildParams.bBuildSimpleCollision = false;
+	BuildParams.bFastBuild = true;
+	Mesh->BuildFromMeshDescriptions({ &MeshDescription }, BuildParams);
+
+	Mesh->CreateBodySetup();
+	Mesh->GetBodySetup()->CollisionTraceFlag = CTF_UseComplexAsSimple;
+	Mesh->GetBodySetup()->CreatePhysicsMeshes();
+	return Mesh;
+}
+#endif
+
+int32 UAlphaRampWeldCommandlet::Main(const FString& Params)
+{
+	FString PackageName;
+
+	if (!FParse::Value(*Params, TEXT("Map="), PackageName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UAlphaRampWeldCommandlet needs -Map=<package>"));
+		return 1;
+	}
+
+	FAlphaRampWeldParams WeldParams;
+	FParse::Value(*Params, TEXT("WeldDistance="), WeldParams.WeldDistance);
+	FParse::Value(*Params, TEXT("SeamAngle="), WeldParams.MaxSeamAngle);
+
+	FString RampTag = FAlphaBenchmarkMapGenerator::SurfRampTag.ToString();
+	FParse::Value(*Params, TEXT("Tag="), RampTag);
+
+#if WITH_EDITOR
+	UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+	UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+
+	if (World == nullptr)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UAlphaRampWeldCommandlet failed to load %s"), *PackageName);
+		return 1;
+	}
+
+	World->WorldType = EWorldType::Editor;
+
+	if (!World->bIsWorldInitialized)
+		World->InitWorld();
+
+	World->UpdateWorldComponents(true, false);
+
+	FAlphaRampWelder Welder;
+	TArray<FAlphaRampSurface> Surfaces;
+	TArray<AStaticMeshActor*> Ramps;
+	TArray<AActor*> StaleWelds;
+	FBox Bounds(ForceInit);
+
+	for (AActor* Actor : World->PersistentLevel->Actors)
+	{
+		if (Actor == nullptr)
+			continue;
+
+		if (Actor->ActorHasTag(WeldedRampTag))
+		{
+			StaleWelds.Add(Actor);
+			continue;
+		}
+
+		AStaticMeshActor* Ramp = Cast<AStaticMeshActor>(Actor);
+
+		if (Ramp == nullptr || !Ramp->ActorHasTag(FName(*RampTag)) || !AddRampTriangles(Welder, Ramp, Ramps.Num(), Surfaces))
+			continue;
+
+		Ramps.Add(Ramp);
+		Bounds += Ramp->GetComponentsBoundingBox();
+	}
+
+	// from an earlier run
+	for (AActor* Actor : StaleWelds)
+		World->DestroyActor(Actor);
+
+	if (Ramps.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UAlphaRampWeldCommandlet found no actors tagged %s in %s"), *RampTag, *PackageName);
+		World->DestroyWorld(false);
+		return 0;
+	}
+
+	const FAlphaRampWeldResult Result = Welder.Weld(WeldParams);
+	const FVector Origin = Bounds.GetCenter();
+	UStaticMesh* Mesh = BuildWeldedMesh(Package, Result, MakeSurfaceMaterials(Package, Surfaces), Origin);
+
+	const FTransform Transform(Origin);
+	AStaticMeshActor* Welded = World->SpawnActorDeferred<AStaticMeshActor>(AStaticMeshActor::StaticClass(), Transform);
+	Welded->GetStaticMeshComponent()->SetStaticMesh(Mesh);
+	Welded->GetStaticMeshComponent()->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	Welded->SetActorHiddenInGame(true);
+	Welded->Tags.Add(WeldedRampTag);
+	Welded->FinishSpawning(Transform);
+
+	// the pieces keep rendering, the welded mesh takes over their collision
+	for (AStaticMeshActor* Ramp : Ramps)
+		Ramp->GetStaticMeshComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+
+	const FString Filename = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetMapPackageExtension());
+	const bool bSaved = UPackage::SavePackage(Package, World, *Filename, SaveArgs);
+
+	World->DestroyWorld(false);
+
+	if (!bSaved)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UAlphaRampWeldCommandlet failed to save %s"), *Filename);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("UAlphaRampWeldCommandlet welded %d triangles from %d ramp pieces into %d surfaces, removed %d seams"), Result.NumInputTriangles, Ramps.Num(), Result.NumMergedSurfaces, Result.NumSeamsRemoved);
+	return 0;
+#else
+	UE_LOG(LogTemp, Error, TEXT("UAlphaRampWeldCommandlet requires an editor build"));
+	return 1;
+#endif
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include "Commandlets/Commandlet.h"
+#include "UAlphaRampWeldCommandlet.generated.h"
+
+/**
+ * Welds the surf ramps of a map into one collision mesh with FAlphaRampWelder and saves the map.
+ *
+ * Ramp pieces are found by actor tag and keep rendering, but lose their collision to a hidden actor holding the
+ * welded mesh. Running it again replaces the welded actor.
+ *
+ * UnrealEditor-Cmd Alpha.uproject -run=AlphaRampWeld -Map=/Game/Benchmark/AlphaBenchmark_1 -WeldDistance=1 -SeamAngle=1
+ */
+UCLASS()
+class UAlphaRampWeldCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAlphaRampWeldCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/**
+	 * Tag of the actor holding the welded collision
+	 */
+	static const FName WeldedRampTag;
+};